@@ -17,7 +17,9 @@ UTIL_DIR = $$SOURCEDIR/util
 WRL_DIR  = $$SOURCEDIR/wrl
 
 SOURCES += \
+	$$SOURCEDIR/core/Edges.cpp \
 	$$SOURCEDIR/core/Faces.cpp \
+	$$SOURCEDIR/core/TriangleFaces.cpp \
 	$$SOURCEDIR/gui/GuiAboutDialog.cpp \
 	$$SOURCEDIR/gui/GuiGLBuffer.cpp \
 	$$SOURCEDIR/gui/GuiGLHandles.cpp \
@@ -30,13 +32,24 @@ SOURCES += \
 	$$SOURCEDIR/gui/GuiViewerData.cpp \
 	$$SOURCEDIR/io/AppLoader.cpp \
 	$$SOURCEDIR/io/AppSaver.cpp \
+	$$SOURCEDIR/io/LoaderObj.cpp \
+	$$SOURCEDIR/io/LoaderPly.cpp \
 	$$SOURCEDIR/io/LoaderStl.cpp \
 	$$SOURCEDIR/io/LoaderWrl.cpp \
+	$$SOURCEDIR/io/LoaderWrlb.cpp \
+	$$SOURCEDIR/io/SaverGlb.cpp \
+	$$SOURCEDIR/io/SaverPly.cpp \
 	$$SOURCEDIR/io/SaverStl.cpp \
 	$$SOURCEDIR/io/SaverWrl.cpp \
+	$$SOURCEDIR/io/SaverWrlb.cpp \
 	$$SOURCEDIR/io/Tokenizer.cpp \
+	$$SOURCEDIR/io/TokenizerBuffer.cpp \
 	$$SOURCEDIR/io/TokenizerFile.cpp \
+	$$SOURCEDIR/io/TokenizerGzip.cpp \
+	$$SOURCEDIR/io/TokenizerMmap.cpp \
+	$$SOURCEDIR/io/TokenizerReadAhead.cpp \
 	$$SOURCEDIR/io/TokenizerString.cpp \
+	$$SOURCEDIR/io/Writer.cpp \
 	$$SOURCEDIR/util/BBox.cpp \
 	$$SOURCEDIR/util/StaticRotation.cpp \
 	$$SOURCEDIR/wrl/Appearance.cpp \
@@ -56,7 +69,9 @@ SOURCES += \
         $$(NULL)
 
 HEADERS += \
+	$$SOURCEDIR/core/Edges.hpp \
 	$$SOURCEDIR/core/Faces.hpp \
+	$$SOURCEDIR/core/TriangleFaces.hpp \
 	$$SOURCEDIR/gui/GuiAboutDialog.hpp \
 	$$SOURCEDIR/gui/GuiGLBuffer.hpp \
 	$$SOURCEDIR/gui/GuiGLHandles.hpp \
@@ -69,16 +84,31 @@ HEADERS += \
 	$$SOURCEDIR/gui/GuiViewerData.hpp \
 	$$SOURCEDIR/io/AppLoader.hpp \
 	$$SOURCEDIR/io/AppSaver.hpp \
+	$$SOURCEDIR/io/FloatFormat.hpp \
 	$$SOURCEDIR/io/Loader.hpp \
+	$$SOURCEDIR/io/LoaderObj.hpp \
+	$$SOURCEDIR/io/LoaderPly.hpp \
 	$$SOURCEDIR/io/LoaderStl.hpp \
 	$$SOURCEDIR/io/LoaderWrl.hpp \
+	$$SOURCEDIR/io/LoaderWrlb.hpp \
 	$$SOURCEDIR/io/Saver.hpp \
+	$$SOURCEDIR/io/SaverGlb.hpp \
+	$$SOURCEDIR/io/SaverPly.hpp \
 	$$SOURCEDIR/io/SaverStl.hpp \
 	$$SOURCEDIR/io/SaverWrl.hpp \
+	$$SOURCEDIR/io/SaverWrlb.hpp \
+	$$SOURCEDIR/io/StlSink.hpp \
 	$$SOURCEDIR/io/StrException.hpp \
 	$$SOURCEDIR/io/Tokenizer.hpp \
+	$$SOURCEDIR/io/TokenizerBuffer.hpp \
 	$$SOURCEDIR/io/TokenizerFile.hpp \
+	$$SOURCEDIR/io/TokenizerGzip.hpp \
+	$$SOURCEDIR/io/TokenizerMmap.hpp \
+	$$SOURCEDIR/io/TokenizerReadAhead.hpp \
 	$$SOURCEDIR/io/TokenizerString.hpp \
+	$$SOURCEDIR/io/Wrlb.hpp \
+	$$SOURCEDIR/io/WrlKeyword.hpp \
+	$$SOURCEDIR/io/Writer.hpp \
 	$$SOURCEDIR/util/BBox.hpp \
 	$$SOURCEDIR/util/StaticRotation.hpp \
 	$$SOURCEDIR/wrl/Appearance.hpp \
@@ -9,6 +9,7 @@ NAME = DGP2025-A1
 unix:!macx:CONFIG += USE_UNIX_DAEMONIZE
 
 # CONFIG += c++11 c++14 c++17
+CONFIG += c++17
 CONFIG += sdk_no_version_check
 
 ##########################################################################
@@ -40,10 +41,13 @@ win32 {
     QMAKE_CXXFLAGS_WARN_ON += -W3 -wd4396 -wd4100 -wd4996
     QMAKE_LFLAGS += /INCREMENTAL:NO
     DSHOW_LIBS = -lStrmiids -lVfw32 -lOle32 -lOleAut32 -lopengl32
+    # zlib has to be installed, and found by the compiler and linker
+    LIBS += -lzlib
 }
 
 unix:!macx {
     QMAKE_LFLAGS += -Wl
+    LIBS += -lz
     #QMAKE_CXXFLAGS += -g
 }
 
@@ -53,6 +57,7 @@ macx {
     OTHER_CPLUSPLUSFLAGS += -feliminate-unused-debug-types
     # LIBS += -framework Foundation -framework QTKit 
     LIBS += -framework CoreFoundation -framework IOkit
+    LIBS += -lz
 }
 
 CONFIG(release, debug|release) {
@@ -0,0 +1,260 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// Edges.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "Edges.hpp"
+#include "Faces.hpp"
+#include "TriangleFaces.hpp"
+#include <stdint.h>
+#include <thread>
+#include <utility>
+
+// meshes with fewer corners than this per thread are processed on a
+// single thread
+#define EDGES_PARALLEL_SIZE (1<<18)
+
+#define EDGES_RADIX_BITS 8
+#define EDGES_RADIX_SIZE (1<<EDGES_RADIX_BITS)
+
+// calls f(k) for k in [0,nChunks), each one on its own thread
+template <class F>
+static void runChunks(const int nChunks, F f) {
+    if (nChunks == 1) {
+        f(0);
+        return;
+    }
+    vector<thread> threads;
+    for (int k = 0; k < nChunks; ++k) {
+        threads.emplace_back(f, k);
+    }
+    for (thread& t : threads) {
+        t.join();
+    }
+}
+
+// LSD radix sort of the low nBits bits of the keys, carrying the
+// values along. Each pass histograms the digits of every chunk in
+// parallel; scanning the histograms in digit major, chunk minor order
+// gives each chunk its own output positions, so that the chunks are
+// scattered in parallel and every pass is stable.
+static void radixSort(vector<uint64_t>& key, vector<int>& value,
+                      const int nBits, const int nChunks) {
+    const int n = static_cast<int>(key.size());
+    vector<uint64_t> keyOut(n);
+    vector<int> valueOut(n);
+    vector<int> start(nChunks + 1);
+    for (int k = 0; k <= nChunks; ++k) {
+        start[k] = static_cast<int>(static_cast<long long>(n) * k / nChunks);
+    }
+    vector<int> position(static_cast<size_t>(nChunks) * EDGES_RADIX_SIZE);
+    for (int shift = 0; shift < nBits; shift += EDGES_RADIX_BITS) {
+        runChunks(nChunks, [&](const int k) {
+            int* count = &position[static_cast<size_t>(k) * EDGES_RADIX_SIZE];
+            for (int d = 0; d < EDGES_RADIX_SIZE; ++d) count[d] = 0;
+            for (int i = start[k]; i < start[k + 1]; ++i) {
+                ++count[(key[i] >> shift) & (EDGES_RADIX_SIZE - 1)];
+            }
+        });
+        int sum = 0;
+        for (int d = 0; d < EDGES_RADIX_SIZE; ++d) {
+            for (int k = 0; k < nChunks; ++k) {
+                int& p = position[static_cast<size_t>(k) * EDGES_RADIX_SIZE + d];
+                const int c = p;
+                p = sum;
+                sum += c;
+            }
+        }
+        runChunks(nChunks, [&](const int k) {
+            int* next = &position[static_cast<size_t>(k) * EDGES_RADIX_SIZE];
+            for (int i = start[k]; i < start[k + 1]; ++i) {
+                const int p = next[(key[i] >> shift) & (EDGES_RADIX_SIZE - 1)]++;
+                keyOut[p] = key[i];
+                valueOut[p] = value[i];
+            }
+        });
+        key.swap(keyOut);
+        value.swap(valueOut);
+    }
+}
+
+// The half-edge of each corner is packed as the key min*nV+max, which
+// needs fewer radix passes than (min<<32|max) unless nV is very large.
+// The keys of the corners of each chunk are counted, placed after the
+// ones of the previous chunks, and sorted together with their corner
+// indices; the runs of equal keys are the edges.
+template <class FacesT>
+Edges::Edges(const FacesT& faces, const int nThreads) :
+    _nV(faces.getNumberOfVertices()) {
+    const int nC = faces.getNumberOfCorners();
+    _cornerEdge.assign(nC, -1);
+    if (nC <= 0 || _nV <= 0) {
+        return;
+    }
+
+    int nChunks = (nThreads > 0) ? nThreads : static_cast<int>(thread::hardware_concurrency());
+    if (nChunks > nC / EDGES_PARALLEL_SIZE) nChunks = nC / EDGES_PARALLEL_SIZE;
+    if (nChunks < 1) nChunks = 1;
+    vector<int> start(nChunks + 1);
+    for (int k = 0; k <= nChunks; ++k) {
+        start[k] = static_cast<int>(static_cast<long long>(nC) * k / nChunks);
+    }
+
+    const uint64_t nV = static_cast<uint64_t>(_nV);
+    auto halfEdge = [&faces, nV](const int iC, uint64_t& key) {
+        const int iF = faces.getCornerFace(iC);
+        if (iF < 0) {
+            return false;
+        }
+        const int iC1 = faces.getNextCorner(iC);
+        const int first = faces.getFaceFirstCorner(iF);
+        const int iV0 = faces.getFaceVertex(iF, iC - first);
+        const int iV1 = faces.getFaceVertex(iF, iC1 - first);
+        if (iV0 == iV1) {
+            return false;
+        }
+        key = (iV0 < iV1) ? static_cast<uint64_t>(iV0) * nV + iV1
+                          : static_cast<uint64_t>(iV1) * nV + iV0;
+        return true;
+    };
+
+    vector<int> nHalfEdges(nChunks + 1, 0);
+    runChunks(nChunks, [&](const int k) {
+        uint64_t key;
+        int n = 0;
+        for (int iC = start[k]; iC < start[k + 1]; ++iC) {
+            if (halfEdge(iC, key)) ++n;
+        }
+        nHalfEdges[k + 1] = n;
+    });
+    for (int k = 0; k < nChunks; ++k) {
+        nHalfEdges[k + 1] += nHalfEdges[k];
+    }
+    const int nH = nHalfEdges[nChunks];
+
+    vector<uint64_t> key(nH);
+    vector<int> corner(nH);
+    runChunks(nChunks, [&](const int k) {
+        int i = nHalfEdges[k];
+        for (int iC = start[k]; iC < start[k + 1]; ++iC) {
+            if (halfEdge(iC, key[i])) corner[i++] = iC;
+        }
+    });
+
+    int nBits = 0;
+    for (uint64_t maxKey = nV * nV - 1; maxKey > 0; maxKey >>= 1) ++nBits;
+    radixSort(key, corner, nBits, (nH < nChunks * EDGES_PARALLEL_SIZE) ? 1 : nChunks);
+
+    int iE = -1;
+    for (int i = 0; i < nH; ++i) {
+        if (i == 0 || key[i] != key[i - 1]) {
+            _edgeVertex.push_back(static_cast<int>(key[i] / nV));
+            _edgeVertex.push_back(static_cast<int>(key[i] % nV));
+            _edgeFaces.push_back(0);
+            ++iE;
+        }
+        ++_edgeFaces[iE];
+        _cornerEdge[corner[i]] = iE;
+    }
+}
+
+template Edges::Edges(const Faces& faces, const int nThreads);
+template Edges::Edges(const TriangleFaces& faces, const int nThreads);
+
+int Edges::getNumberOfVertices() const {
+    return _nV;
+}
+
+int Edges::getNumberOfEdges() const {
+    return static_cast<int>(_edgeFaces.size());
+}
+
+int Edges::getVertex0(const int iE) const {
+    if (static_cast<unsigned>(iE) >= static_cast<unsigned>(getNumberOfEdges())) {
+        return -1;
+    }
+    return _edgeVertex[2 * iE];
+}
+
+int Edges::getVertex1(const int iE) const {
+    if (static_cast<unsigned>(iE) >= static_cast<unsigned>(getNumberOfEdges())) {
+        return -1;
+    }
+    return _edgeVertex[2 * iE + 1];
+}
+
+int Edges::getEdge(const int iV0, const int iV1) const {
+    const int v0 = (iV0 < iV1) ? iV0 : iV1;
+    const int v1 = (iV0 < iV1) ? iV1 : iV0;
+    int lo = 0, hi = getNumberOfEdges();
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        const int w0 = _edgeVertex[2 * mid];
+        const int w1 = _edgeVertex[2 * mid + 1];
+        if (w0 < v0 || (w0 == v0 && w1 < v1)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < getNumberOfEdges() && _edgeVertex[2 * lo] == v0 && _edgeVertex[2 * lo + 1] == v1) {
+        return lo;
+    }
+    return -1;
+}
+
+int Edges::getCornerEdge(const int iC) const {
+    if (static_cast<unsigned>(iC) >= static_cast<unsigned>(_cornerEdge.size())) {
+        return -1;
+    }
+    return _cornerEdge[iC];
+}
+
+int Edges::getNumberOfEdgeFaces(const int iE) const {
+    if (static_cast<unsigned>(iE) >= static_cast<unsigned>(getNumberOfEdges())) {
+        return 0;
+    }
+    return _edgeFaces[iE];
+}
+
+bool Edges::isBoundaryEdge(const int iE) const {
+    return getNumberOfEdgeFaces(iE) == 1;
+}
+
+bool Edges::isRegularEdge(const int iE) const {
+    return getNumberOfEdgeFaces(iE) == 2;
+}
+
+bool Edges::isSingularEdge(const int iE) const {
+    return getNumberOfEdgeFaces(iE) > 2;
+}
@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// Edges.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef _EDGES_HPP_
+#define _EDGES_HPP_
+
+#include <vector>
+
+using namespace std;
+
+// The unique edges of a polygon mesh. Every pair of consecutive
+// corners (iC,getNextCorner(iC)) of a face defines a half-edge; the
+// half-edges with the same two vertices, in either order, share the
+// same edge. The edges are numbered in increasing order of their
+// (min,max) vertex pairs, which are sorted with a radix sort.
+//
+// The constructor is a template on the faces class, so that an Edges
+// object can be built from a Faces or from a TriangleFaces object.
+
+class Edges {
+
+public:
+
+  // the half-edges of large meshes are sorted on nThreads threads;
+  // 0 means one thread per core
+  template <class FacesT>
+          Edges(const FacesT& faces, const int nThreads=0);
+
+  int     getNumberOfVertices()                    const;
+  int     getNumberOfEdges()                       const;
+
+  // If iE is a valid edge index, these methods return the smaller and
+  // the larger of the two vertex indices of the edge. Otherwise they
+  // return -1.
+  int     getVertex0(const int iE)                 const;
+  int     getVertex1(const int iE)                 const;
+
+  // If iV0 and iV1 are the two vertices of an edge, in any order, this
+  // method returns its index; otherwise it returns -1. It is a binary
+  // search over the sorted edges.
+  int     getEdge(const int iV0, const int iV1)    const;
+
+  // If iC is a valid corner index, and it does not correspond to a -1
+  // separator, this method returns the index of the edge joining the
+  // corner iC and the next corner of the same face. Otherwise, or if
+  // both corners have the same vertex, it returns -1.
+  int     getCornerEdge(const int iC)              const;
+
+  // If iE is a valid edge index, this method returns the number of
+  // half-edges which share the edge; i.e., the number of faces
+  // incident to the edge, counting a face twice if it contains the
+  // edge twice. Otherwise it returns 0.
+  int     getNumberOfEdgeFaces(const int iE)       const;
+
+  // Edges with one, two, and more than two incident faces.
+  bool    isBoundaryEdge(const int iE)             const;
+  bool    isRegularEdge(const int iE)              const;
+  bool    isSingularEdge(const int iE)             const;
+
+private:
+
+  int         _nV;
+  vector<int> _edgeVertex;      // 2*nE vertex indices, iV0<iV1
+  vector<int> _edgeFaces;       // nE incident face counts
+  vector<int> _cornerEdge;      // nC edge indices, -1 for the separators
+
+};
+
+#endif /* _EDGES_HPP_ */
@@ -37,93 +37,183 @@
 #include <math.h>
 #include "Faces.hpp"
 #include <algorithm>
-//TODO: This could be better implemented with an auxiliary array that stores the starting idx for each face
-// idxArray[i] = <idx where face i starts in coordIndex>. I want to test the trivial implementation first and refactor it later.
-Faces::Faces(const int nV, const vector<int>& coordIndex) {
-    _coordIndex = coordIndex; // vector deep copy
-    _faceStartingIndex = vector<int>();
-    _nV = nV;
-    _faceStartingIndex.push_back(0);
-    int nextFace = 1;
-    for (size_t i = 0; i < _coordIndex.size() - 1; ++i) {
-        if (_coordIndex[i] < 0) {
-            _faceStartingIndex.push_back(i + 1);
-            _coordIndex[i] = -nextFace;
-            ++nextFace;
+#include <utility>
+#include <thread>
+
+// the constructors build two lookup arrays, so that every accessor
+// is O(1), over the coordIndex array, which is either copied, moved,
+// or borrowed:
+//
+// _faceFirstCorner : CSR offsets, with nF+1 entries; the corners of
+//                    face iF are [_faceFirstCorner[iF],_faceFirstCorner[iF+1]-1),
+//                    and the separator of face iF is _faceFirstCorner[iF+1]-1
+// _cornerFace      : the face of each corner, or -1 for the separators
+Faces::Faces(const int nV, const vector<int>& coordIndex, const int nThreads) :
+    _nV(nV),
+    _ownCoordIndex(coordIndex) {
+    _coordIndex = _ownCoordIndex.data();
+    _nC = static_cast<int>(_ownCoordIndex.size());
+    build(nThreads);
+}
+
+// a moved vector keeps its buffer, so _coordIndex remains valid when
+// this object is moved as well
+Faces::Faces(const int nV, vector<int>&& coordIndex, const int nThreads) :
+    _nV(nV),
+    _ownCoordIndex(std::move(coordIndex)) {
+    _coordIndex = _ownCoordIndex.data();
+    _nC = static_cast<int>(_ownCoordIndex.size());
+    build(nThreads);
+}
+
+Faces::Faces(const int nV, const int* coordIndex, const int nC, const int nThreads) :
+    _nV(nV),
+    _coordIndex(coordIndex),
+    _nC((coordIndex != nullptr && nC > 0) ? nC : 0) {
+    build(nThreads);
+}
+
+// meshes with fewer corners than this are indexed on a single thread
+#define FACES_PARALLEL_SIZE (1<<20)
+
+void Faces::build(const int nThreads) {
+    const int nC = _nC;
+    size_t nChunks = (nThreads > 0) ? static_cast<size_t>(nThreads) : thread::hardware_concurrency();
+    if (nChunks > static_cast<size_t>(nC / FACES_PARALLEL_SIZE)) {
+        nChunks = static_cast<size_t>(nC / FACES_PARALLEL_SIZE);
+    }
+    if (nChunks > 1) {
+        buildParallel(static_cast<int>(nChunks));
+        return;
+    }
+    _cornerFace.resize(nC);
+    _faceFirstCorner.push_back(0);
+    int iF = 0;
+    for (int iC = 0; iC < nC; ++iC) {
+        const int iV = _coordIndex[iC];
+        if (iV < 0) {
+            _cornerFace[iC] = -1;
+            _faceFirstCorner.push_back(iC + 1);
+            ++iF;
+        } else {
+            _cornerFace[iC] = iF;
+            if (iV >= _nV) _nV = iV + 1;
         }
     }
-    _coordIndex[_coordIndex.size() - 1] = -nextFace;
+    // a last face without a separator ends at a virtual one
+    if (nC > 0 && _coordIndex[nC - 1] >= 0) {
+        _faceFirstCorner.push_back(nC + 1);
+    }
+}
+
+// the same arrays as the serial scan, built in two parallel passes
+// over contiguous chunks of coordIndex: the first one counts the
+// separators of each chunk, an exclusive scan of the counts gives the
+// number of the first face of each chunk, and the second pass fills
+// both arrays
+void Faces::buildParallel(const int nChunks) {
+    const int nC = _nC;
+    vector<int> start(nChunks + 1);
+    for (int k = 0; k <= nChunks; ++k) {
+        start[k] = static_cast<int>(static_cast<long long>(nC) * k / nChunks);
+    }
+
+    vector<int> nSeparators(nChunks, 0);
+    vector<int> maxVertex(nChunks, -1);
+    vector<thread> threads;
+    for (int k = 0; k < nChunks; ++k) {
+        threads.emplace_back([&, k]() {
+            int n = 0, m = -1;
+            for (int iC = start[k]; iC < start[k + 1]; ++iC) {
+                const int iV = _coordIndex[iC];
+                if (iV < 0) ++n; else if (iV > m) m = iV;
+            }
+            nSeparators[k] = n;
+            maxVertex[k] = m;
+        });
+    }
+    for (thread& t : threads) {
+        t.join();
+    }
+    threads.clear();
+
+    vector<int> firstFace(nChunks + 1, 0);
+    for (int k = 0; k < nChunks; ++k) {
+        firstFace[k + 1] = firstFace[k] + nSeparators[k];
+        if (maxVertex[k] >= _nV) _nV = maxVertex[k] + 1;
+    }
+    const int nF = firstFace[nChunks];
+    const bool virtualSeparator = (nC > 0 && _coordIndex[nC - 1] >= 0);
+
+    _cornerFace.resize(nC);
+    _faceFirstCorner.resize(nF + 1 + (virtualSeparator ? 1 : 0));
+    _faceFirstCorner[0] = 0;
+    for (int k = 0; k < nChunks; ++k) {
+        threads.emplace_back([&, k]() {
+            int iF = firstFace[k];
+            for (int iC = start[k]; iC < start[k + 1]; ++iC) {
+                if (_coordIndex[iC] < 0) {
+                    _cornerFace[iC] = -1;
+                    _faceFirstCorner[++iF] = iC + 1;
+                } else {
+                    _cornerFace[iC] = iF;
+                }
+            }
+        });
+    }
+    for (thread& t : threads) {
+        t.join();
+    }
+    if (virtualSeparator) {
+        _faceFirstCorner[nF + 1] = nC + 1;
+    }
 }
 
 int Faces::getNumberOfVertices() const {
-    _nV; // TODO: check this value in the constructos
+    return _nV;
 }
 
 int Faces::getNumberOfFaces() const {
-    return _faceStartingIndex.size();
+    return static_cast<int>(_faceFirstCorner.size()) - 1;
 }
 
 int Faces::getNumberOfCorners() const {
-    return _coordIndex.size();
+    return _nC;
 }
 
 int Faces::getFaceSize(const int iF) const {
-    int faceIdx = getFaceFirstCorner(iF);
-    if (faceIdx < 0) {
+    if (static_cast<unsigned>(iF) >= static_cast<unsigned>(getNumberOfFaces())) {
         return 0;
     }
-    int count = 0;
-    for(; faceIdx < _coordIndex.size(); ++faceIdx) {
-        if (_coordIndex[faceIdx] < 0) break;
-        ++count;
-    }
-    return count;
+    return _faceFirstCorner[iF + 1] - _faceFirstCorner[iF] - 1;
 }
 
 int Faces::getFaceFirstCorner(const int iF) const {
-    if (iF < 0 || iF >= _faceStartingIndex.size()) {
+    if (static_cast<unsigned>(iF) >= static_cast<unsigned>(getNumberOfFaces())) {
         return -1;
     }
-    return _faceStartingIndex[iF];
+    return _faceFirstCorner[iF];
 }
 
 int Faces::getFaceVertex(const int iF, const int j) const {
-    int faceSize = getFaceSize(iF);
-    if (faceSize == 0 || j >= faceSize) {
+    if (static_cast<unsigned>(j) >= static_cast<unsigned>(getFaceSize(iF))) {
         return -1;
     }
-    int faceIdx = getFaceFirstCorner(iF);
-    return _coordIndex[faceIdx + j];
+    return _coordIndex[_faceFirstCorner[iF] + j];
 }
 
 int Faces::getCornerFace(const int iC) const {
-    int vectorSize = _coordIndex.size();
-    if (iC >= vectorSize) {
+    if (static_cast<unsigned>(iC) >= static_cast<unsigned>(_cornerFace.size())) {
         return -1;
     }
-    if (_coordIndex[iC] < 0) {
-        return -1;
-    }
-    for (size_t i = iC; i < _coordIndex.size(); ++i) {
-        if (_coordIndex[i] < 0) {
-            return -_coordIndex[i] - 1;
-        }
-    }
+    return _cornerFace[iC];
 }
 
 int Faces::getNextCorner(const int iC) const {
-    int vectorSize = _coordIndex.size();
-    if (iC >= vectorSize) {
+    const int iF = getCornerFace(iC);
+    if (iF < 0) {
         return -1;
     }
-    if (_coordIndex[iC] < 0) {
-        return -1;
-    }
-    int nextCoordValue = _coordIndex[iC + 1];
-    if (nextCoordValue < 0) {
-        return _faceStartingIndex[-nextCoordValue - 1];
-    } else {
-        return iC + 1;
-    }
+    // the corner after the last one of the face is its separator
+    return (iC + 2 < _faceFirstCorner[iF + 1]) ? iC + 1 : _faceFirstCorner[iF];
 }
-
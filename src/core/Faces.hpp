@@ -44,17 +44,36 @@ using namespace std;
 class Faces {
   
 public:
-          Faces(const int nV, const vector<int>& coordIndex);
-
-  // The constructor should compare the nV value passed as a parameter
-  // with the non-negative values in stored in the coordIndex index
-  // array, and update the value of nV stored internally if
-  // necessary. This value returns the updated value;
+          // the lookup arrays of large meshes are built on nThreads
+          // threads; 0 means one thread per core
+
+          // copies the coordIndex array
+          Faces(const int nV, const vector<int>& coordIndex,
+                const int nThreads=0);
+          // takes ownership of the coordIndex array
+          Faces(const int nV, vector<int>&& coordIndex,
+                const int nThreads=0);
+          // borrows the nC entries of the coordIndex array, which
+          // should not change or be freed while this object is used
+          Faces(const int nV, const int* coordIndex, const int nC,
+                const int nThreads=0);
+
+          // the borrowed or owned coordIndex is not copied
+          Faces(const Faces&)            = delete;
+          Faces& operator=(const Faces&) = delete;
+          Faces(Faces&&)                 = default;
+          Faces& operator=(Faces&&)      = default;
+
+  // The constructor compares the nV value passed as a parameter with
+  // the non-negative values stored in the coordIndex index array, and
+  // updates the value of nV stored internally if necessary. This
+  // method returns the updated value. All the accessors are O(1).
   int     getNumberOfVertices()                    const;
 
-  // The faces are conted in the constructor by counting the number of
+  // The faces are counted in the constructor by counting the number of
   // -1's in the coordIndex array. If coordIndex is not empty, the
-  // last value of coordIndex should be -1.
+  // last value of coordIndex should be -1; otherwise the last face
+  // is also counted.
   int     getNumberOfFaces()                       const;
 
   // The number of corners is defined as the size of the coordIndex
@@ -89,9 +108,15 @@ public:
 
 private:
 
-  int _nV;
-  vector<int> _coordIndex;
-  vector<int> _faceStartingIndex;
+  int         _nV;
+  const int*  _coordIndex;      // borrowed, or _ownCoordIndex.data()
+  int         _nC;
+  vector<int> _ownCoordIndex;   // empty when borrowed
+  vector<int> _faceFirstCorner; // nF+1 CSR offsets, see Faces.cpp
+  vector<int> _cornerFace;      // -1 for the separators
+
+  void build(const int nThreads);
+  void buildParallel(const int nChunks);
 
 };
 
@@ -0,0 +1,71 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// TriangleFaces.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "TriangleFaces.hpp"
+#include <utility>
+
+TriangleFaces::TriangleFaces(const int nV, const vector<int>& coordIndex, const int /*nThreads*/) :
+    _nV(nV),
+    _ownCoordIndex(coordIndex) {
+    _coordIndex = _ownCoordIndex.data();
+    _nC = static_cast<int>(_ownCoordIndex.size());
+    build();
+}
+
+TriangleFaces::TriangleFaces(const int nV, vector<int>&& coordIndex, const int /*nThreads*/) :
+    _nV(nV),
+    _ownCoordIndex(std::move(coordIndex)) {
+    _coordIndex = _ownCoordIndex.data();
+    _nC = static_cast<int>(_ownCoordIndex.size());
+    build();
+}
+
+TriangleFaces::TriangleFaces(const int nV, const int* coordIndex, const int nC, const int /*nThreads*/) :
+    _nV(nV),
+    _coordIndex(coordIndex),
+    _nC((coordIndex != nullptr && nC > 0) ? nC : 0) {
+    build();
+}
+
+// the only pass over coordIndex updates nV, as in the Faces class;
+// a last triangle without a separator has 3 entries left over
+void TriangleFaces::build() {
+    _nF = (_nC + 1) / 4;
+    const int n = 4 * _nF;
+    for (int iC = 0; iC < n && iC < _nC; ++iC) {
+        const int iV = _coordIndex[iC];
+        if (iV >= _nV) _nV = iV + 1;
+    }
+}
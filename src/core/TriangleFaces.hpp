@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// TriangleFaces.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef _TRIANGLE_FACES_HPP_
+#define _TRIANGLE_FACES_HPP_
+
+#include <vector>
+
+using namespace std;
+
+// A variant of the Faces class for triangle meshes, i.e. for
+// coordIndex arrays for which IndexedFaceSet::isTriangleMesh() returns
+// true. It has the same constructors and accessors, with the same
+// meaning, so that code written as a template on the faces class works
+// with both. Since every face is stored as "i0 i1 i2 -1", faces and
+// corners are related arithmetically, and no lookup arrays are built:
+// corner iC belongs to face iC/4, and face iF starts at corner 4*iF.
+// The accessors are defined inline in this header.
+//
+// If the last triangle is not followed by a -1 separator it is still
+// counted; trailing entries which do not complete a triangle are not
+// part of any face.
+
+class TriangleFaces {
+  
+public:
+          // the nThreads argument is only there so that both classes
+          // can be constructed in the same way; it is ignored
+
+          // copies the coordIndex array
+          TriangleFaces(const int nV, const vector<int>& coordIndex,
+                        const int nThreads=0);
+          // takes ownership of the coordIndex array
+          TriangleFaces(const int nV, vector<int>&& coordIndex,
+                        const int nThreads=0);
+          // borrows the nC entries of the coordIndex array, which
+          // should not change or be freed while this object is used
+          TriangleFaces(const int nV, const int* coordIndex, const int nC,
+                        const int nThreads=0);
+
+          TriangleFaces(const TriangleFaces&)            = delete;
+          TriangleFaces& operator=(const TriangleFaces&) = delete;
+          TriangleFaces(TriangleFaces&&)                 = default;
+          TriangleFaces& operator=(TriangleFaces&&)      = default;
+
+  int     getNumberOfVertices()                    const { return _nV; }
+  int     getNumberOfFaces()                       const { return _nF; }
+  int     getNumberOfCorners()                     const { return _nC; }
+
+  int     getFaceSize(const int iF)                const {
+    return (static_cast<unsigned>(iF) < static_cast<unsigned>(_nF)) ? 3 : 0;
+  }
+
+  int     getFaceFirstCorner(const int iF)         const {
+    return (static_cast<unsigned>(iF) < static_cast<unsigned>(_nF)) ? 4 * iF : -1;
+  }
+
+  int     getFaceVertex(const int iF, const int j) const {
+    if (static_cast<unsigned>(iF) >= static_cast<unsigned>(_nF) ||
+        static_cast<unsigned>(j) >= 3u) {
+      return -1;
+    }
+    return _coordIndex[4 * iF + j];
+  }
+
+  int     getCornerFace(const int iC)              const {
+    if (static_cast<unsigned>(iC) >= static_cast<unsigned>(4 * _nF) ||
+        (iC & 3) == 3) {
+      return -1;
+    }
+    return iC >> 2;
+  }
+
+  int     getNextCorner(const int iC)              const {
+    if (getCornerFace(iC) < 0) {
+      return -1;
+    }
+    return ((iC & 3) == 2) ? iC - 2 : iC + 1;
+  }
+
+private:
+
+  int         _nV;
+  const int*  _coordIndex;      // borrowed, or _ownCoordIndex.data()
+  int         _nC;
+  int         _nF;
+  vector<int> _ownCoordIndex;   // empty when borrowed
+
+  void build();
+
+};
+
+#endif /* _TRIANGLE_FACES_HPP_ */
@@ -53,6 +53,15 @@
 #include "io/LoaderStl.hpp"
 #include "io/SaverStl.hpp"
 
+#include "io/LoaderWrlb.hpp"
+#include "io/SaverWrlb.hpp"
+
+#include "io/LoaderPly.hpp"
+#include "io/SaverPly.hpp"
+
+#include "io/LoaderObj.hpp"
+#include "io/SaverGlb.hpp"
+
 int     GuiMainWindow::_timerInterval = 20;
 int     GuiMainWindow::_lDPI          = 96;
 QString GuiMainWindow::_platformName  = "unknown";
@@ -66,13 +75,32 @@ GuiMainWindow::GuiMainWindow(QWidget* parent):
 
   LoaderWrl* wrlLoader = new LoaderWrl();
   _loader.registerLoader(wrlLoader);
+  _loader.registerLoader(wrlLoader,"wrz");
+  _loader.registerLoader(wrlLoader,"wrl.gz");
   SaverWrl* wrlSaver = new SaverWrl();
   _saver.registerSaver(wrlSaver);
 
   LoaderStl* stlLoader = new LoaderStl();
   _loader.registerLoader(stlLoader);
-  SaverStl* stlSaver = new SaverStl();
-  _saver.registerSaver(stlSaver);
+  _loader.registerLoader(stlLoader,"stl.gz");
+  _stlSaver = new SaverStl();
+  _saver.registerSaver(_stlSaver);
+
+  LoaderWrlb* wrlbLoader = new LoaderWrlb();
+  _loader.registerLoader(wrlbLoader);
+  SaverWrlb* wrlbSaver = new SaverWrlb();
+  _saver.registerSaver(wrlbSaver);
+
+  LoaderPly* plyLoader = new LoaderPly();
+  _loader.registerLoader(plyLoader);
+  SaverPly* plySaver = new SaverPly();
+  _saver.registerSaver(plySaver);
+
+  LoaderObj* objLoader = new LoaderObj();
+  objLoader->setNumberOfThreads(0);
+  _loader.registerLoader(objLoader);
+  SaverGlb* glbSaver = new SaverGlb();
+  _saver.registerSaver(glbSaver);
 
   // for animation
   _timer = new QTimer(this);
@@ -142,7 +170,7 @@ void GuiMainWindow::on_fileLoadAction_triggered() {
   QFileDialog fileDialog(this);
   fileDialog.setFileMode(QFileDialog::ExistingFile); // allowed to select only one 
   fileDialog.setAcceptMode(QFileDialog::AcceptOpen);
-  fileDialog.setNameFilter(tr("3D Files (*.wrl *.stl)"));
+  fileDialog.setNameFilter(tr("3D Files (*.wrl *.stl *.wrlb *.ply *.obj *.wrz *.wrl.gz *.stl.gz)"));
   QStringList fileNames;
   if(fileDialog.exec()) {
     fileNames = fileDialog.selectedFiles();
@@ -175,12 +203,17 @@ void GuiMainWindow::on_fileSaveAction_triggered() {
   // TODO Sat Sep 10 22:18:57 2016
   // get list of file extensions from registered Savers
 
-  fileDialog.setNameFilter(tr("3D Files (*.wrl *.stl)"));
+  QString binaryStlFilter(tr("Binary STL Files (*.stl)"));
+  QStringList nameFilters;
+  nameFilters << tr("3D Files (*.wrl *.stl *.wrlb *.ply *.glb)") << binaryStlFilter;
+  fileDialog.setNameFilters(nameFilters);
   QStringList fileNames;
   if(fileDialog.exec()) {
     fileNames = fileDialog.selectedFiles();
     if(fileNames.size()>0)
       filename = fileNames.at(0).toStdString();
+    // STL files are saved in binary only if requested
+    _stlSaver->setBinary(fileDialog.selectedNameFilter()==binaryStlFilter);
   }
 
   // restart animation
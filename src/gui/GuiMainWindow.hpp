@@ -43,6 +43,7 @@
 // #include <QGridLayout>
 #include <io/AppLoader.hpp>
 #include <io/AppSaver.hpp>
+#include <io/SaverStl.hpp>
 // #include "GuiGLWidget.hpp"
 // #include "GuiToolsWidget.hpp"
 #include <string>
@@ -93,6 +94,7 @@ private:
 
   AppLoader       _loader;
   AppSaver        _saver;
+  SaverStl*       _stlSaver;
   QTimer         *_timer;
 
   static int      _timerInterval;
@@ -32,32 +32,46 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <mutex>
 #include "AppLoader.hpp"
 
 bool AppLoader::load(const char* filename, SceneGraph& wrl) {
   bool success = false;
+  Loader* loader = getLoader(filename);
+  if(loader!=(Loader*)0)
+    success = loader->load(filename,wrl);
+  return success;
+}
+
+// the extension is the longest registered suffix after a '.', so that
+// double extensions such as "wrl.gz" take precedence over "gz"
+Loader* AppLoader::getLoader(const char* filename) const {
+  Loader* loader = (Loader*)0;
   if(filename!=(const char*)0) {
+    shared_lock<shared_mutex> lock(_mutex);
     // int n = (int)strlen(filename);
     string f(filename);
     int n = static_cast<int>(f.size());
-    int i;
-    for(i=n-1;i>=0;i--)
-      if(filename[i]=='.')
-        break;
-    if(i>=0) {
-      string ext(filename+i+1);
-      Loader* loader = _registry[ext];
-      if(loader!=(Loader*)0)
-        success = loader->load(filename,wrl);
+    for(int i=0;i<n && loader==(Loader*)0;i++) {
+      if(filename[i]=='.') {
+        map<string,Loader*>::const_iterator it = _registry.find(string(filename+i+1));
+        if(it!=_registry.end()) loader = it->second;
+      }
     }
   }
-  return success;
+  return loader;
 }
 
 void AppLoader::registerLoader(Loader* loader) {
-  if(loader!=(Loader*)0) {
-    string ext(loader->ext()); // constructed from const char*
-    pair<string,Loader*> ext_loader(ext,loader);
+  if(loader!=(Loader*)0)
+    registerLoader(loader,loader->ext());
+}
+
+void AppLoader::registerLoader(Loader* loader, const char* ext) {
+  if(loader!=(Loader*)0 && ext!=(const char*)0) {
+    string e(ext); // constructed from const char*
+    pair<string,Loader*> ext_loader(e,loader);
+    unique_lock<shared_mutex> lock(_mutex);
     _registry.insert(ext_loader);
   }
 }
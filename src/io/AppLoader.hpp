@@ -37,6 +37,7 @@
 
 #include <map>
 #include <string>
+#include <shared_mutex>
 #include "LoaderWrl.hpp"
 
 using namespace std;
@@ -48,12 +49,19 @@ public:
   AppLoader() {}
   ~AppLoader() {}
 
-  bool load(const char* filename, SceneGraph& wrl);
-  void registerLoader(Loader* loader);
+  // files may be loaded from several threads at once, and loaders
+  // may be registered while other threads are loading files
+  bool    load(const char* filename, SceneGraph& wrl);
+  void    registerLoader(Loader* loader);
+  // registers the loader for another extension, such as "wrl.gz"
+  void    registerLoader(Loader* loader, const char* ext);
+  // returns the loader registered for the file extension, or null
+  Loader* getLoader(const char* filename) const;
 
 private:
 
-  map<string, Loader*> _registry;
+  map<string, Loader*>  _registry;
+  mutable shared_mutex  _mutex;
 
 };
 
@@ -32,10 +32,26 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <mutex>
 #include "AppSaver.hpp"
 
 bool AppSaver::save(const char* filename, SceneGraph& wrl) {
+  return save(filename,wrl,FloatFormat());
+}
+
+bool AppSaver::save
+(const char* filename, SceneGraph& wrl, const FloatFormat& format) {
   bool success = false;
+  Saver* saver = getSaver(filename);
+  if(saver!=(Saver*)0)
+    success = saver->save(filename,wrl,format);
+  return success;
+}
+
+// the extension is the suffix after the last '.'; the registry is only
+// searched, since inserting into it would race with other threads
+Saver* AppSaver::getSaver(const char* filename) const {
+  Saver* saver = (Saver*)0;
   if(filename!=(const char*)0) {
     // int n = (int)strlen(filename);
     string f(filename);
@@ -45,19 +61,19 @@ bool AppSaver::save(const char* filename, SceneGraph& wrl) {
       if(filename[i]=='.')
         break;
     if(i>=0) {
-      string ext(filename+i+1);
-      Saver* saver = _registry[ext];
-      if(saver!=(Saver*)0)
-        success = saver->save(filename,wrl);
+      shared_lock<shared_mutex> lock(_mutex);
+      map<string,Saver*>::const_iterator it = _registry.find(string(filename+i+1));
+      if(it!=_registry.end()) saver = it->second;
     }
   }
-  return success;
+  return saver;
 }
 
 void AppSaver::registerSaver(Saver* saver) {
   if(saver!=(Saver*)0) {
     string ext(saver->ext()); // constructed from const char*
     pair<string,Saver*> ext_saver(ext,saver);
+    unique_lock<shared_mutex> lock(_mutex);
     _registry.insert(ext_saver);
   }
 }
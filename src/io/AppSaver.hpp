@@ -37,6 +37,7 @@
 
 #include <map>
 #include <string>
+#include <shared_mutex>
 #include "SaverWrl.hpp"
 
 using namespace std;
@@ -48,12 +49,19 @@ public:
   AppSaver() {}
   ~AppSaver() {}
 
-  bool save(const char* filename, SceneGraph& wrl);
-  void registerSaver(Saver* saver);
+  // as with AppLoader, files may be saved from several threads at once
+  bool   save(const char* filename, SceneGraph& wrl);
+  // floating point values are written according to format,
+  // by those savers which write them as text
+  bool   save(const char* filename, SceneGraph& wrl, const FloatFormat& format);
+  void   registerSaver(Saver* saver);
+  // returns the saver registered for the file extension, or null
+  Saver* getSaver(const char* filename) const;
 
 private:
 
-  map<string, Saver*> _registry;
+  map<string, Saver*>  _registry;
+  mutable shared_mutex _mutex;
 
 };
 
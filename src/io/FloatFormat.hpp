@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// FloatFormat.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef _FLOAT_FORMAT_HPP_
+#define _FLOAT_FORMAT_HPP_
+
+// selects how the text savers write floating point values
+//
+// DEFAULT   : the saver's own historical format
+//             (%8.4f for SaverWrl, %f for SaverStl)
+// FIXED     : fixed notation with the given number of decimal digits
+// SHORTEST  : shortest string which reads back to the same float
+// QUANTIZED : values rounded to the nearest multiple of the tolerance,
+//             then written as SHORTEST
+//
+// the number of FIXED digits is clamped to [0,FLOAT_FORMAT_MAX_DIGITS];
+// more digits than this are not significant for a float
+
+#define FLOAT_FORMAT_MAX_DIGITS 9
+
+class FloatFormat {
+
+public:
+
+  enum Policy { DEFAULT, FIXED, SHORTEST, QUANTIZED };
+
+  FloatFormat(const Policy policy=DEFAULT,
+              const int digits=4, const float tolerance=0.0f):
+    _policy(policy),
+    _digits((digits<0)?0:(digits>FLOAT_FORMAT_MAX_DIGITS)?
+            FLOAT_FORMAT_MAX_DIGITS:digits),
+    _tolerance(tolerance) {
+  }
+
+  static FloatFormat fixed(const int digits) {
+    return FloatFormat(FIXED,digits);
+  }
+  static FloatFormat shortest() {
+    return FloatFormat(SHORTEST);
+  }
+  static FloatFormat quantized(const float tolerance) {
+    return FloatFormat(QUANTIZED,0,tolerance);
+  }
+
+  Policy getPolicy()    const { return _policy;    }
+  int    getDigits()    const { return _digits;    }
+  float  getTolerance() const { return _tolerance; }
+
+  // replaces DEFAULT by the saver's own format
+  FloatFormat resolve(const FloatFormat& saverDefault) const {
+    return (_policy==DEFAULT)?saverDefault:*this;
+  }
+
+private:
+
+  Policy _policy;
+  int    _digits;
+  float  _tolerance;
+
+};
+
+#endif /* _FLOAT_FORMAT_HPP_ */
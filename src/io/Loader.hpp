@@ -41,6 +41,8 @@ class Loader {
 
 public:
 
+  // load may be called from several threads at once, each one with its
+  // own SceneGraph, so loaders should not keep per file state
   virtual bool  load(const char* filename, SceneGraph& wrl) = 0;
   virtual const char* ext() const = 0;
 
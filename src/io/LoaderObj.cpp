@@ -0,0 +1,365 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// LoaderObj.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <string.h>
+#include <charconv>
+#include <thread>
+#include "LoaderObj.hpp"
+#include "Tokenizer.hpp"
+#include "TokenizerMmap.hpp"
+#include "StrException.hpp"
+
+const char* LoaderObj::_ext = "obj";
+
+// files smaller than this are parsed on a single thread
+#define OBJ_PARALLEL_CHUNK_SIZE (1<<22)
+
+// the arrays parsed from a range of lines; indices are stored 0 based,
+// and the positions of relative indices, which can only be resolved
+// once the number of values in the previous chunks is known, are
+// remembered as well
+class ObjChunk {
+public:
+  vector<float>  coord;
+  vector<float>  normal;
+  vector<float>  texCoord;
+  vector<int>    coordIndex;
+  vector<int>    normalIndex;
+  vector<int>    texCoordIndex;
+  vector<size_t> coordRelative;
+  vector<size_t> normalRelative;
+  vector<size_t> texCoordRelative;
+  size_t         nCornersWithoutNormal;
+  size_t         nCornersWithoutTexCoord;
+  StrException*  error;
+  ObjChunk():
+    nCornersWithoutNormal(0),
+    nCornersWithoutTexCoord(0),
+    error((StrException*)0) {
+  }
+};
+
+static inline bool isObjBlank(const char c) {
+  return (c==' ' || c=='\t' || c=='\r');
+}
+
+static inline const char* skipObjBlanks(const char* b, const char* e) {
+  while(b<e && isObjBlank(*b)) b++;
+  return b;
+}
+
+static inline const char* endObjToken(const char* b, const char* e) {
+  while(b<e && isObjBlank(*b)==false) b++;
+  return b;
+}
+
+static StrException* objLineError(const char* msg, const char* b, const char* e) {
+  const char* r = e;
+  while(r>b && isObjBlank(r[-1])) r--;
+  return new StrException(string(msg)+" \""+string(b,r)+"\"");
+}
+
+// parses up to n floats into the array, and returns how many were found
+static size_t parseObjFloats
+(const char* b, const char* e, vector<float>& values, const size_t n,
+ const char* line) {
+  size_t i = 0;
+  for(;i<n;i++) {
+    b = skipObjBlanks(b,e);
+    if(b==e) break;
+    const char* t = endObjToken(b,e);
+    float f;
+    if(Tokenizer::parseFloat(b,t,f)==false)
+      throw objLineError("bad OBJ value in line",line,e);
+    values.push_back(f);
+    b = t;
+  }
+  return i;
+}
+
+// stores the 1 based, or negative relative, index v as a 0 based index
+static inline void pushObjIndex
+(const int v, const size_t nValues, vector<int>& index, vector<size_t>& relative) {
+  if(v>0) {
+    index.push_back(v-1);
+  } else {
+    relative.push_back(index.size());
+    index.push_back((int)nValues+v);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+// f v1[/vt1[/vn1]] v2[/vt2[/vn2]] ...
+void LoaderObj::parseFace(const char* line, const char* e, ObjChunk& chunk) const {
+  const char* b = endObjToken(line,e);
+  const size_t nCoord    = chunk.coord.size()/3;
+  const size_t nNormal   = chunk.normal.size()/3;
+  const size_t nTexCoord = chunk.texCoord.size()/2;
+  const size_t first     = chunk.coordIndex.size();
+  while((b=skipObjBlanks(b,e))<e) {
+    const char* t = endObjToken(b,e);
+    int v[3] = { 0, 0, 0 };
+    for(int j=0;j<3 && b<t;j++) {
+      const char* s = (const char*)memchr(b,'/',t-b);
+      if(s==(const char*)0) s = t;
+      if(s>b) {
+        from_chars_result r = from_chars(b,s,v[j]);
+        if(r.ec!=errc() || r.ptr!=s || v[j]==0)
+          throw objLineError("bad OBJ index in line",line,e);
+      }
+      b = (s<t)?s+1:t;
+    }
+    if(b<t || v[0]==0) throw objLineError("bad OBJ corner in line",line,e);
+    pushObjIndex(v[0],nCoord,chunk.coordIndex,chunk.coordRelative);
+    // missing normal and texture coordinate indices are stored as 0,
+    // and the field is dropped later
+    if(v[1]!=0)
+      pushObjIndex(v[1],nTexCoord,chunk.texCoordIndex,chunk.texCoordRelative);
+    else {
+      chunk.texCoordIndex.push_back(0);
+      chunk.nCornersWithoutTexCoord++;
+    }
+    if(v[2]!=0)
+      pushObjIndex(v[2],nNormal,chunk.normalIndex,chunk.normalRelative);
+    else {
+      chunk.normalIndex.push_back(0);
+      chunk.nCornersWithoutNormal++;
+    }
+    b = t;
+  }
+  const size_t nCorners = chunk.coordIndex.size()-first;
+  if(nCorners==0) throw objLineError("empty OBJ face in line",line,e);
+  chunk.coordIndex.push_back(-1);
+  chunk.normalIndex.push_back(-1);
+  chunk.texCoordIndex.push_back(-1);
+}
+
+//////////////////////////////////////////////////////////////////////
+void LoaderObj::parseChunk(const char* b, const char* e, ObjChunk& chunk) const {
+  while(b<e) {
+    const char* eol = (const char*)memchr(b,'\n',e-b);
+    if(eol==(const char*)0) eol = e;
+    const char* line = skipObjBlanks(b,eol);
+    const char* t    = endObjToken(line,eol);
+    const size_t n   = t-line;
+    if(n==1 && line[0]=='v') {
+      if(parseObjFloats(t,eol,chunk.coord,3,line)!=3)
+        throw objLineError("expecting 3 coordinates in line",line,eol);
+    } else if(n==2 && line[0]=='v' && line[1]=='n') {
+      if(parseObjFloats(t,eol,chunk.normal,3,line)!=3)
+        throw objLineError("expecting 3 normal coordinates in line",line,eol);
+    } else if(n==2 && line[0]=='v' && line[1]=='t') {
+      // the optional third texture coordinate is ignored, and a missing
+      // second one is 0
+      size_t nValues = parseObjFloats(t,eol,chunk.texCoord,2,line);
+      if(nValues==0)
+        throw objLineError("expecting texture coordinates in line",line,eol);
+      if(nValues==1) chunk.texCoord.push_back(0.0f);
+    } else if(n==1 && line[0]=='f') {
+      parseFace(line,eol,chunk);
+    }
+    b = eol+1;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+size_t LoaderObj::numberOfChunks(const size_t size) const {
+  size_t nThreads =
+    (_nThreads>0)?(size_t)_nThreads:(size_t)thread::hardware_concurrency();
+  size_t nChunks = size/OBJ_PARALLEL_CHUNK_SIZE;
+  if(nChunks>nThreads) nChunks = nThreads;
+  return (nChunks>1)?nChunks:1;
+}
+
+// appends the chunk values and indices to the IndexedFaceSet arrays,
+// resolving the relative indices of the chunk
+static void appendObjValues
+(vector<float>& dst, vector<float>& src,
+ vector<int>& dstIndex, vector<int>& srcIndex,
+ const vector<size_t>& relative, const int nValuesBefore) {
+  const size_t first = dstIndex.size();
+  dst.insert(dst.end(),src.begin(),src.end());
+  dstIndex.insert(dstIndex.end(),srcIndex.begin(),srcIndex.end());
+  for(size_t i : relative) {
+    int& index = dstIndex[first+i];
+    index += nValuesBefore;
+    if(index<0) throw new StrException("OBJ relative index out of range");
+  }
+  vector<float>().swap(src);
+  vector<int>().swap(srcIndex);
+}
+
+static void checkObjIndex(const vector<int>& index, const size_t nValues, const char* name) {
+  for(int i : index)
+    if(i>=(int)nValues)
+      throw new StrException(string("OBJ ")+name+" index out of range");
+}
+
+//////////////////////////////////////////////////////////////////////
+bool LoaderObj::load(const char* filename, SceneGraph& wrl) {
+  bool success = false;
+
+  // clear the scene graph
+  wrl.clear();
+  wrl.setUrl("");
+
+  vector<ObjChunk> chunk;
+
+  try {
+
+    if(filename==(char*)0) throw new StrException("filename==null");
+
+    // map the file
+    TokenizerMmap map(filename);
+    if(map.isMapped()==false) throw new StrException("unable to map file");
+    const char* data = map.getData();
+    size_t      size = map.getSize();
+
+    // split the file at line boundaries
+    size_t nChunks = numberOfChunks(size);
+    vector<size_t> start(1,0);
+    for(size_t k=1;k<nChunks;k++) {
+      size_t offset = k*(size/nChunks);
+      const char* eol = (const char*)memchr(data+offset,'\n',size-offset);
+      offset = (eol==(const char*)0)?size:(size_t)(eol+1-data);
+      if(offset>start.back() && offset<size) start.push_back(offset);
+    }
+    start.push_back(size);
+    nChunks = start.size()-1;
+
+    // parse the chunks
+    chunk.resize(nChunks);
+    if(nChunks==1) {
+      parseChunk(data,data+size,chunk[0]);
+    } else {
+      vector<thread> threads;
+      for(size_t k=0;k<nChunks;k++) {
+        threads.emplace_back([&,k]() {
+          try {
+            parseChunk(data+start[k],data+start[k+1],chunk[k]);
+          } catch(StrException* e) {
+            chunk[k].error = e;
+          }
+        });
+      }
+      for(thread& t : threads)
+        t.join();
+      // report the first error in file order
+      for(size_t k=0;k<nChunks;k++) {
+        if(chunk[k].error!=(StrException*)0) {
+          StrException* e = chunk[k].error;
+          chunk[k].error = (StrException*)0;
+          throw e;
+        }
+      }
+    }
+
+    wrl.setUrl(filename);
+
+    // same scene graph structure as created by LoaderStl
+    Shape* shape = new Shape();
+    wrl.addChild(shape);
+    Appearance* appearance = new Appearance();
+    shape->setAppearance(appearance);
+    Material* material = new Material();
+    appearance->setMaterial(material);
+    IndexedFaceSet* ifs = new IndexedFaceSet();
+    shape->setGeometry(ifs);
+
+    vector<float>& coord         = ifs->getCoord();
+    vector<float>& normal        = ifs->getNormal();
+    vector<float>& texCoord      = ifs->getTexCoord();
+    vector<int>&   coordIndex    = ifs->getCoordIndex();
+    vector<int>&   normalIndex   = ifs->getNormalIndex();
+    vector<int>&   texCoordIndex = ifs->getTexCoordIndex();
+
+    size_t nCorners = 0, nCoord = 0, nNormal = 0, nTexCoord = 0;
+    size_t nCornersWithoutNormal = 0, nCornersWithoutTexCoord = 0;
+    for(const ObjChunk& c : chunk) {
+      nCorners  += c.coordIndex.size();
+      nCoord    += c.coord.size();
+      nNormal   += c.normal.size();
+      nTexCoord += c.texCoord.size();
+      nCornersWithoutNormal   += c.nCornersWithoutNormal;
+      nCornersWithoutTexCoord += c.nCornersWithoutTexCoord;
+    }
+    const bool hasNormal   = (nNormal>0   && nCornersWithoutNormal==0);
+    const bool hasTexCoord = (nTexCoord>0 && nCornersWithoutTexCoord==0);
+
+    coord.reserve(nCoord);
+    coordIndex.reserve(nCorners);
+    if(hasNormal) {
+      normal.reserve(nNormal);
+      normalIndex.reserve(nCorners);
+    }
+    if(hasTexCoord) {
+      texCoord.reserve(nTexCoord);
+      texCoordIndex.reserve(nCorners);
+    }
+
+    for(ObjChunk& c : chunk) {
+      appendObjValues(coord,c.coord,coordIndex,c.coordIndex,
+                      c.coordRelative,(int)(coord.size()/3));
+      if(hasNormal)
+        appendObjValues(normal,c.normal,normalIndex,c.normalIndex,
+                        c.normalRelative,(int)(normal.size()/3));
+      if(hasTexCoord)
+        appendObjValues(texCoord,c.texCoord,texCoordIndex,c.texCoordIndex,
+                        c.texCoordRelative,(int)(texCoord.size()/2));
+    }
+    chunk.clear();
+
+    checkObjIndex(coordIndex,coord.size()/3,"vertex");
+    checkObjIndex(normalIndex,normal.size()/3,"normal");
+    checkObjIndex(texCoordIndex,texCoord.size()/2,"texture coordinate");
+
+    // normals are bound per corner through normalIndex
+    ifs->setNormalPerVertex(true);
+
+    success = true;
+
+  } catch(StrException* e) { 
+
+    fprintf(stderr,"ERROR | %s\n",e->what());
+    delete e;
+    for(ObjChunk& c : chunk)
+      delete c.error;
+    wrl.clear();
+    wrl.setUrl("");
+
+  }
+
+  return success;
+}
@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// LoaderObj.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef _LOADER_OBJ_HPP_
+#define _LOADER_OBJ_HPP_
+
+#include "Loader.hpp"
+#include <wrl/Shape.hpp>
+#include <wrl/Appearance.hpp>
+#include <wrl/Material.hpp>
+#include <wrl/IndexedFaceSet.hpp>
+
+class ObjChunk;
+
+// loads Wavefront OBJ files as a single Shape with an IndexedFaceSet;
+// the v, vt and vn lines fill the coord, texCoord and normal fields,
+// and the v/vt/vn corners of the f lines fill coordIndex, texCoordIndex
+// and normalIndex, so that normals and texture coordinates are bound
+// per corner; they are only kept if every corner has them; negative
+// (relative) indices are supported, and the other lines are ignored
+//
+// the file is mapped into memory and parsed line by line without the
+// Tokenizer; large files are split at line boundaries into chunks,
+// which are parsed on separate threads
+
+class LoaderObj : public Loader {
+
+private:
+
+  const static char* _ext;
+
+  int _nThreads;
+
+  size_t numberOfChunks(const size_t size) const;
+  void   parseChunk(const char* b, const char* e, ObjChunk& chunk) const;
+  void   parseFace(const char* line, const char* e, ObjChunk& chunk) const;
+
+public:
+
+  LoaderObj() : _nThreads(1) {};
+  ~LoaderObj() {};
+
+  // large files are split into chunks which are parsed on this many
+  // threads; 0 means one thread per core
+  int   getNumberOfThreads() const     { return _nThreads; }
+  void  setNumberOfThreads(int value)  { _nThreads = value; }
+
+  bool  load(const char* filename, SceneGraph& wrl);
+  const char* ext() const { return _ext; }
+
+};
+
+#endif /* _LOADER_OBJ_HPP_ */
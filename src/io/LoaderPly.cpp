@@ -0,0 +1,471 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// LoaderPly.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <stdint.h>
+#include <string.h>
+#include <string_view>
+#include "LoaderPly.hpp"
+#include "TokenizerBuffer.hpp"
+#include "TokenizerMmap.hpp"
+#include "StrException.hpp"
+
+const char* LoaderPly::_ext = "ply";
+
+//////////////////////////////////////////////////////////////////////
+// header
+
+enum PlyType {
+  PLY_NONE = 0,
+  PLY_INT8,
+  PLY_UINT8,
+  PLY_INT16,
+  PLY_UINT16,
+  PLY_INT32,
+  PLY_UINT32,
+  PLY_FLOAT32,
+  PLY_FLOAT64
+};
+
+static PlyType plyType(const string& name) {
+  if(name=="char"   || name=="int8"   ) return PLY_INT8;
+  if(name=="uchar"  || name=="uint8"  ) return PLY_UINT8;
+  if(name=="short"  || name=="int16"  ) return PLY_INT16;
+  if(name=="ushort" || name=="uint16" ) return PLY_UINT16;
+  if(name=="int"    || name=="int32"  ) return PLY_INT32;
+  if(name=="uint"   || name=="uint32" ) return PLY_UINT32;
+  if(name=="float"  || name=="float32") return PLY_FLOAT32;
+  if(name=="double" || name=="float64") return PLY_FLOAT64;
+  throw new StrException("unknown PLY property type \""+name+"\"");
+}
+
+static size_t plySize(const PlyType type) {
+  switch(type) {
+  case PLY_INT8:    case PLY_UINT8:   return 1;
+  case PLY_INT16:   case PLY_UINT16:  return 2;
+  case PLY_INT32:   case PLY_UINT32:
+  case PLY_FLOAT32:                   return 4;
+  case PLY_FLOAT64:                   return 8;
+  default:                            return 0;
+  }
+}
+
+// integer color components are scaled to [0,1]
+static float plyColorScale(const PlyType type) {
+  switch(type) {
+  case PLY_UINT8:  return 1.0f/255.0f;
+  case PLY_UINT16: return 1.0f/65535.0f;
+  default:         return 1.0f;
+  }
+}
+
+// where the values of a property are stored
+enum PlyTarget {
+  PLY_SKIP = -1,
+  PLY_X = 0, PLY_Y, PLY_Z,
+  PLY_NX, PLY_NY, PLY_NZ,
+  PLY_RED, PLY_GREEN, PLY_BLUE,
+  PLY_VERTEX_INDICES
+};
+
+class PlyProperty {
+public:
+  string  name;
+  PlyType type;
+  PlyType countType; // PLY_NONE unless the property is a list
+  int     target;
+};
+
+class PlyElement {
+public:
+  string              name;
+  size_t              count;
+  vector<PlyProperty> property;
+  // size of each record, or 0 if the element has list properties
+  size_t recordSize() const {
+    size_t size = 0;
+    for(const PlyProperty& p : property) {
+      if(p.countType!=PLY_NONE) return 0;
+      size += plySize(p.type);
+    }
+    return size;
+  }
+};
+
+static int plyTarget(const string& element, const PlyProperty& p) {
+  if(element=="vertex" && p.countType==PLY_NONE) {
+    static const char* name[] =
+      { "x", "y", "z", "nx", "ny", "nz", "red", "green", "blue" };
+    for(int i=0;i<9;i++)
+      if(p.name==name[i]) return i;
+  } else if(element=="face" && p.countType!=PLY_NONE) {
+    if(p.name=="vertex_indices" || p.name=="vertex_index")
+      return PLY_VERTEX_INDICES;
+  }
+  return PLY_SKIP;
+}
+
+//////////////////////////////////////////////////////////////////////
+// binary values
+
+static bool plyHostIsLittleEndian() {
+  const uint16_t one = 1;
+  return *(const uint8_t*)&one==1;
+}
+
+static inline double plyValue(const char* p, const PlyType type, const bool swap) {
+  char b[8];
+  const size_t n = plySize(type);
+  if(swap)
+    for(size_t i=0;i<n;i++) b[i] = p[n-1-i];
+  else
+    memcpy(b,p,n);
+  switch(type) {
+  case PLY_INT8:    { int8_t   v; memcpy(&v,b,1); return v; }
+  case PLY_UINT8:   { uint8_t  v; memcpy(&v,b,1); return v; }
+  case PLY_INT16:   { int16_t  v; memcpy(&v,b,2); return v; }
+  case PLY_UINT16:  { uint16_t v; memcpy(&v,b,2); return v; }
+  case PLY_INT32:   { int32_t  v; memcpy(&v,b,4); return v; }
+  case PLY_UINT32:  { uint32_t v; memcpy(&v,b,4); return v; }
+  case PLY_FLOAT32: { float    v; memcpy(&v,b,4); return v; }
+  case PLY_FLOAT64: { double   v; memcpy(&v,b,8); return v; }
+  default:          return 0.0;
+  }
+}
+
+// bounds checked sequential access to the binary body
+class PlyBinaryReader {
+
+public:
+
+  PlyBinaryReader(const char* data, const size_t size, const bool swap):
+    _data(data),_size(size),_pos(0),_swap(swap) {
+  }
+
+  const char* take(const size_t n) {
+    if(n>_size-_pos) throw new StrException("unexpected end of file");
+    const char* p = _data+_pos;
+    _pos += n;
+    return p;
+  }
+
+  double get(const PlyType type) {
+    return plyValue(take(plySize(type)),type,_swap);
+  }
+
+  // takes count records of the given size at once
+  const char* takeRecords(const size_t count, const size_t size) {
+    if(size>0 && count>(_size-_pos)/size)
+      throw new StrException("unexpected end of file");
+    return take(count*size);
+  }
+
+  bool swap() const { return _swap; }
+
+private:
+
+  const char* _data;
+  size_t      _size;
+  size_t      _pos;
+  bool        _swap;
+};
+
+// the ascii body, read with the Tokenizer
+class PlyAsciiReader {
+
+public:
+
+  PlyAsciiReader(const char* data, const size_t size):
+    _tkn(data,size) {
+  }
+
+  double get(const PlyType type) {
+    bool success = false;
+    double value = 0.0;
+    if(type==PLY_FLOAT32 || type==PLY_FLOAT64) {
+      float f;
+      if((success=_tkn.getFloat(f))) value = f;
+    } else if(type==PLY_UINT32) {
+      unsigned int ui;
+      if((success=_tkn.getUInt(ui))) value = ui;
+    } else {
+      int i;
+      if((success=_tkn.getInt(i))) value = i;
+    }
+    if(success==false) throw new StrException("expecting PLY value");
+    return value;
+  }
+
+private:
+
+  TokenizerBuffer _tkn;
+};
+
+//////////////////////////////////////////////////////////////////////
+// elements
+
+// reads the records one property at a time
+template<class Reader>
+static void plyLoadElement
+(Reader& rd, const PlyElement& e, IndexedFaceSet& ifs, const size_t nVertices) {
+  vector<float>& coord      = ifs.getCoord();
+  vector<float>& normal     = ifs.getNormal();
+  vector<float>& color      = ifs.getColor();
+  vector<int>&   coordIndex = ifs.getCoordIndex();
+  for(size_t i=0;i<e.count;i++) {
+    for(const PlyProperty& p : e.property) {
+      if(p.countType!=PLY_NONE) {
+        double n = rd.get(p.countType);
+        if(n<0.0) throw new StrException("negative PLY list length");
+        size_t nValues = (size_t)n;
+        for(size_t j=0;j<nValues;j++) {
+          double value = rd.get(p.type);
+          if(p.target==PLY_VERTEX_INDICES) {
+            if(value<0.0 || value>=(double)nVertices)
+              throw new StrException("PLY vertex index out of range");
+            coordIndex.push_back((int)value);
+          }
+        }
+        if(p.target==PLY_VERTEX_INDICES) coordIndex.push_back(-1);
+      } else {
+        double value = rd.get(p.type);
+        switch(p.target) {
+        case PLY_X: case PLY_Y: case PLY_Z:
+          coord[3*i+(p.target-PLY_X)] = (float)value;
+          break;
+        case PLY_NX: case PLY_NY: case PLY_NZ:
+          normal[3*i+(p.target-PLY_NX)] = (float)value;
+          break;
+        case PLY_RED: case PLY_GREEN: case PLY_BLUE:
+          color[3*i+(p.target-PLY_RED)] =
+            (float)value*plyColorScale(p.type);
+          break;
+        default:
+          break;
+        }
+      }
+    }
+  }
+}
+
+// binary elements without lists are taken as a single block, and the
+// properties are read at fixed offsets in each record
+static void plyLoadRecords
+(PlyBinaryReader& rd, const PlyElement& e, IndexedFaceSet& ifs) {
+  const size_t size = e.recordSize();
+  const char*  data = rd.takeRecords(e.count,size);
+  if(e.name!="vertex") return;
+  vector<float>* dst[3] = { &ifs.getCoord(), &ifs.getNormal(), &ifs.getColor() };
+  vector<size_t> offset;
+  size_t o = 0;
+  for(const PlyProperty& p : e.property) {
+    offset.push_back(o);
+    o += plySize(p.type);
+  }
+  for(size_t k=0;k<e.property.size();k++) {
+    const PlyProperty& p = e.property[k];
+    if(p.target<PLY_X || p.target>PLY_BLUE) continue;
+    float* v     = dst[p.target/3]->data()+p.target%3;
+    float  scale = (p.target>=PLY_RED)?plyColorScale(p.type):1.0f;
+    const char* record = data+offset[k];
+    if(p.type==PLY_FLOAT32 && rd.swap()==false) {
+      for(size_t i=0;i<e.count;i++,record+=size,v+=3)
+        memcpy(v,record,sizeof(float));
+    } else {
+      for(size_t i=0;i<e.count;i++,record+=size,v+=3)
+        *v = (float)plyValue(record,p.type,rd.swap())*scale;
+    }
+  }
+}
+
+// the most common face element, a single list of uchar counts and
+// int indices, is copied in bulk
+static bool plyLoadFaces
+(PlyBinaryReader& rd, const PlyElement& e, IndexedFaceSet& ifs,
+ const size_t nVertices) {
+  if(e.property.size()!=1 || rd.swap()) return false;
+  const PlyProperty& p = e.property[0];
+  if(p.target!=PLY_VERTEX_INDICES || p.countType!=PLY_UINT8 ||
+     (p.type!=PLY_INT32 && p.type!=PLY_UINT32))
+    return false;
+  vector<int>& coordIndex = ifs.getCoordIndex();
+  coordIndex.reserve(4*e.count);
+  for(size_t i=0;i<e.count;i++) {
+    size_t n = (uint8_t)*rd.take(1);
+    const char* index = rd.takeRecords(n,sizeof(int32_t));
+    size_t size = coordIndex.size();
+    coordIndex.resize(size+n);
+    memcpy(coordIndex.data()+size,index,n*sizeof(int32_t));
+    for(size_t j=size;j<size+n;j++)
+      if((uint32_t)coordIndex[j]>=(uint32_t)nVertices)
+        throw new StrException("PLY vertex index out of range");
+    coordIndex.push_back(-1);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+bool LoaderPly::load(const char* filename, SceneGraph& wrl) {
+  bool success = false;
+
+  // clear the scene graph
+  wrl.clear();
+  wrl.setUrl("");
+
+  try {
+
+    if(filename==(char*)0) throw new StrException("filename==null");
+
+    // map the file
+    TokenizerMmap map(filename);
+    if(map.isMapped()==false) throw new StrException("unable to map file");
+    const char* data = map.getData();
+    size_t      size = map.getSize();
+
+    // the header ends with the end_header line
+    string_view text(data,size);
+    size_t end = text.find("end_header");
+    if(text.compare(0,3,"ply")!=0 || end==string_view::npos)
+      throw new StrException("not a PLY file");
+    end = text.find('\n',end);
+    end = (end==string_view::npos)?size:end+1;
+
+    // parse the header
+    TokenizerBuffer tkn(data,end);
+    tkn.get();
+    string format = "";
+    vector<PlyElement> element;
+    while(tkn.get("expecting end_header"),tkn.equals("end_header")==false) {
+      if(tkn.equals("format")) {
+        tkn.get("expecting PLY format");
+        format = tkn;
+        tkn.nextline();
+      } else if(tkn.equals("comment") || tkn.equals("obj_info")) {
+        tkn.nextline();
+      } else if(tkn.equals("element")) {
+        PlyElement e;
+        tkn.get("expecting element name");
+        e.name = tkn;
+        unsigned int count;
+        if(tkn.getUInt(count)==false)
+          throw new StrException("expecting element count");
+        e.count = count;
+        element.push_back(e);
+      } else if(tkn.equals("property")) {
+        if(element.size()==0)
+          throw new StrException("PLY property before any element");
+        PlyProperty p;
+        p.countType = PLY_NONE;
+        tkn.get("expecting property type");
+        if(tkn.equals("list")) {
+          tkn.get("expecting list count type");
+          p.countType = plyType(tkn);
+          tkn.get("expecting list value type");
+        }
+        p.type = plyType(tkn);
+        tkn.get("expecting property name");
+        p.name = tkn;
+        p.target = plyTarget(element.back().name,p);
+        element.back().property.push_back(p);
+      } else {
+        throw new StrException("unexpected token \""+string(tkn)+"\" in PLY header");
+      }
+    }
+
+    const bool ascii = (format=="ascii");
+    const bool swap  =
+      (format=="binary_little_endian")?!plyHostIsLittleEndian():
+      (format=="binary_big_endian")   ? plyHostIsLittleEndian():false;
+    if(ascii==false &&
+       format!="binary_little_endian" && format!="binary_big_endian")
+      throw new StrException("unknown PLY format \""+format+"\"");
+
+    wrl.setUrl(filename);
+
+    // same scene graph structure as created by LoaderStl
+    Shape* shape = new Shape();
+    wrl.addChild(shape);
+    Appearance* appearance = new Appearance();
+    shape->setAppearance(appearance);
+    Material* material = new Material();
+    appearance->setMaterial(material);
+    IndexedFaceSet* ifs = new IndexedFaceSet();
+    shape->setGeometry(ifs);
+
+    // allocate the vertex arrays for the properties present
+    size_t nVertices = 0;
+    for(const PlyElement& e : element) {
+      if(e.name!="vertex") continue;
+      nVertices = e.count;
+      bool has[3] = { false, false, false };
+      for(const PlyProperty& p : e.property)
+        if(p.target>=PLY_X && p.target<=PLY_BLUE) has[p.target/3] = true;
+      if(has[0]==false) throw new StrException("PLY vertices without x,y,z");
+      ifs->getCoord().assign(3*nVertices,0.0f);
+      if(has[1]) ifs->getNormal().assign(3*nVertices,0.0f);
+      if(has[2]) ifs->getColor().assign(3*nVertices,0.0f);
+    }
+    ifs->setNormalPerVertex(true);
+    ifs->setColorPerVertex(true);
+
+    // read the elements in the order they were declared
+    const char* body = data+end;
+    size_t      bodySize = size-end;
+    if(ascii) {
+      PlyAsciiReader rd(body,bodySize);
+      for(const PlyElement& e : element)
+        plyLoadElement(rd,e,*ifs,nVertices);
+    } else {
+      PlyBinaryReader rd(body,bodySize,swap);
+      for(const PlyElement& e : element) {
+        if(e.recordSize()>0)
+          plyLoadRecords(rd,e,*ifs);
+        else if(e.name!="face" || plyLoadFaces(rd,e,*ifs,nVertices)==false)
+          plyLoadElement(rd,e,*ifs,nVertices);
+      }
+    }
+
+    success = true;
+
+  } catch(StrException* e) { 
+
+    fprintf(stderr,"ERROR | %s\n",e->what());
+    delete e;
+    wrl.clear();
+    wrl.setUrl("");
+
+  }
+
+  return success;
+}
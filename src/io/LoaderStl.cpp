@@ -35,7 +35,18 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdio.h>
-#include "TokenizerFile.hpp"
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <string_view>
+#include <thread>
+#include <memory>
+#include <zlib.h>
+#include "TokenizerMmap.hpp"
+#include "TokenizerBuffer.hpp"
+#include "TokenizerReadAhead.hpp"
+#include "TokenizerGzip.hpp"
 #include "LoaderStl.hpp"
 #include "StrException.hpp"
 
@@ -50,48 +61,485 @@
 
 const char* LoaderStl::_ext = "stl";
 
-bool LoaderStl::parseFace(Tokenizer &tkn, vector<float> &normal, vector<int> &coordIndex, vector<float> &coord, uint facetNumber) {
-    Vec3f vec3fBuffer;
-    float floatBuffer;
+// reads the normal and the three vertices of one facet; returns false
+// if the next token is not "facet"
+bool LoaderStl::parseFacet(Tokenizer &tkn, float values[12]) {
     if(!(tkn.expecting("facet") && tkn.expecting("normal"))) {
         return false;
     }
 
-    bool success = tkn.getVec3f(vec3fBuffer);
-    if (!success) {
-        throw StrException("Invalid stl file, failed to read float value");
-    }
-
-    // One normal per vertex (Can I save memory by not repeating this information?)
-    for (int i = 0; i < 3; ++i) {
-        normal.push_back(vec3fBuffer.x);
-        normal.push_back(vec3fBuffer.y);
-        normal.push_back(vec3fBuffer.z);
+    for (int j = 0; j < 3; ++j) {
+        if (!tkn.getFloat(values[j])) {
+            throw new StrException("Invalid stl file, failed to read float value");
+        }
     }
 
     if(!(tkn.expecting("outer") && tkn.expecting("loop"))) {
-        throw StrException("Invalid stl file, expecting outer loop");
+        throw new StrException("Invalid stl file, expecting outer loop");
     }
 
     for (int i = 0; i < 3; ++i) {
         if (!tkn.expecting("vertex")) {
-            throw StrException("Invalid stl file, expecting vertex");
+            throw new StrException("Invalid stl file, expecting vertex");
         }
         for (int j = 0; j < 3; ++j) {
-            bool success = tkn.getFloat(floatBuffer);
-            if (!success) {
-                throw StrException("Invalid stl file, failed to read float value");
+            if (!tkn.getFloat(values[3 + 3 * i + j])) {
+                throw new StrException("Invalid stl file, failed to read float value");
             }
-            coord.push_back(floatBuffer);
         }
-        coordIndex.push_back(3 * facetNumber + i); // The coords for each facet are <v1 v2 v3> counterclockwise
     }
-    coordIndex.push_back(-1);
     tkn.expecting("endloop");
     tkn.expecting("endfacet");
     return true;
 }
 
+bool LoaderStl::parseFace(Tokenizer &tkn, vector<float> &normal, vector<int> &coordIndex, vector<float> &coord, uint facetNumber) {
+    float values[12];
+    if (!parseFacet(tkn, values)) {
+        return false;
+    }
+
+    // One normal per vertex, or one per face if the vertices are welded
+    for (int i = (_weld ? 2 : 0); i < 3; ++i) {
+        normal.insert(normal.end(), values, values + 3);
+    }
+
+    // The coords for each facet are <v1 v2 v3> counterclockwise
+    coord.insert(coord.end(), values + 3, values + 12);
+    for (int i = 0; i < 3; ++i) {
+        coordIndex.push_back(3 * facetNumber + i);
+    }
+    coordIndex.push_back(-1);
+    return true;
+}
+
+// parses facets until a token other than "facet" is found, and
+// returns true if the end of the input was reached
+bool LoaderStl::parseFaces(Tokenizer &tkn, vector<float> &normal, vector<int> &coordIndex, vector<float> &coord) {
+    uint facetNumber = 0;
+    while (parseFace(tkn, normal, coordIndex, coord, facetNumber)) {
+        ++facetNumber;
+    }
+    return tkn.length() == 0;
+}
+
+// ascii files smaller than this are parsed on a single thread
+#define STL_PARALLEL_CHUNK_SIZE (1<<22)
+
+size_t LoaderStl::numberOfChunks(size_t size) const {
+    size_t nThreads = (_nThreads > 0) ? static_cast<size_t>(_nThreads) : thread::hardware_concurrency();
+    size_t nChunks = size / STL_PARALLEL_CHUNK_SIZE;
+    if (nChunks > nThreads) nChunks = nThreads;
+    return (nChunks > 1) ? nChunks : 1;
+}
+
+static inline bool isStlBlank(const char c) {
+    return (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',');
+}
+
+// returns the offset of the first "facet" token at or after the given
+// offset, or size if there is none
+static size_t findFacet(const char* data, size_t size, size_t from) {
+    string_view text(data, size);
+    for (size_t i = from; (i = text.find("facet", i)) != string_view::npos; ++i) {
+        if ((i == 0 || isStlBlank(data[i - 1])) && (i + 5 == size || isStlBlank(data[i + 5]))) {
+            return i;
+        }
+    }
+    return size;
+}
+
+// the file is split at "facet" tokens into one chunk per thread, each
+// chunk is parsed into its own arrays, and the arrays are appended in
+// file order; as in the sequential parser, parsing stops at the first
+// token other than "facet", and chunks after it are discarded
+void LoaderStl::parseParallel(const char* data, size_t size, size_t nChunks, vector<float> &normal, vector<int> &coordIndex, vector<float> &coord) {
+    vector<size_t> start(1, 0);
+    for (size_t k = 1; k < nChunks; ++k) {
+        size_t offset = findFacet(data, size, k * (size / nChunks));
+        if (offset > start.back() && offset < size) {
+            start.push_back(offset);
+        }
+    }
+    start.push_back(size);
+    nChunks = start.size() - 1;
+
+    vector<vector<float>> chunkNormal(nChunks);
+    vector<vector<int>> chunkCoordIndex(nChunks);
+    vector<vector<float>> chunkCoord(nChunks);
+    vector<char> chunkComplete(nChunks, 0);
+    vector<StrException*> chunkError(nChunks, nullptr);
+
+    vector<thread> threads;
+    for (size_t k = 0; k < nChunks; ++k) {
+        threads.emplace_back([&, k]() {
+            try {
+                TokenizerBuffer tkn(data + start[k], start[k + 1] - start[k]);
+                if (k == 0 && !(tkn.expecting("solid") && tkn.get())) {
+                    throw new StrException("Invalid stl file, expecting solid");
+                }
+                chunkComplete[k] = parseFaces(tkn, chunkNormal[k], chunkCoordIndex[k], chunkCoord[k]);
+            } catch (StrException* e) {
+                chunkError[k] = e;
+            }
+        });
+    }
+    for (thread& t : threads) {
+        t.join();
+    }
+
+    size_t nChunksUsed = 0;
+    StrException* error = nullptr;
+    for (size_t k = 0; k < nChunks && error == nullptr; ++k) {
+        nChunksUsed = k + 1;
+        error = chunkError[k];
+        if (!chunkComplete[k]) break;
+    }
+    for (size_t k = 0; k < nChunks; ++k) {
+        if (chunkError[k] != error) delete chunkError[k];
+    }
+    if (error != nullptr) {
+        throw error;
+    }
+
+    size_t nNormal = 0, nCoordIndex = 0, nCoord = 0;
+    for (size_t k = 0; k < nChunksUsed; ++k) {
+        nNormal += chunkNormal[k].size();
+        nCoordIndex += chunkCoordIndex[k].size();
+        nCoord += chunkCoord[k].size();
+    }
+    normal.reserve(nNormal);
+    coordIndex.reserve(nCoordIndex);
+    coord.reserve(nCoord);
+    for (size_t k = 0; k < nChunksUsed; ++k) {
+        int offset = static_cast<int>(coord.size() / 3);
+        normal.insert(normal.end(), chunkNormal[k].begin(), chunkNormal[k].end());
+        coord.insert(coord.end(), chunkCoord[k].begin(), chunkCoord[k].end());
+        for (int iV : chunkCoordIndex[k]) {
+            coordIndex.push_back(iV < 0 ? iV : iV + offset);
+        }
+        vector<float>().swap(chunkNormal[k]);
+        vector<float>().swap(chunkCoord[k]);
+        vector<int>().swap(chunkCoordIndex[k]);
+    }
+}
+
+// a binary STL file is made of an 80 byte header, a uint32 number of
+// triangles, and then a 50 byte record for each triangle
+#define STL_BINARY_HEADER_SIZE 84
+#define STL_BINARY_RECORD_SIZE 50
+
+bool LoaderStl::isBinary(const char* data, size_t size) {
+    if (size < STL_BINARY_HEADER_SIZE) {
+        return false;
+    }
+    // many binary files also start with "solid", so the size of the
+    // file is the only reliable test
+    uint32_t nFacets;
+    memcpy(&nFacets, data + 80, sizeof(uint32_t));
+    return size == STL_BINARY_HEADER_SIZE + static_cast<size_t>(nFacets) * STL_BINARY_RECORD_SIZE;
+}
+
+void LoaderStl::loadBinary(const char* data, vector<float> &normal, vector<int> &coordIndex, vector<float> &coord) {
+    uint32_t nFacets;
+    memcpy(&nFacets, data + 80, sizeof(uint32_t));
+
+    // the number of triangles is known in advance
+    coord.resize(9 * static_cast<size_t>(nFacets));
+    normal.resize((_weld ? 3 : 9) * static_cast<size_t>(nFacets));
+    coordIndex.resize(4 * static_cast<size_t>(nFacets));
+    loadBinaryRecords(data + STL_BINARY_HEADER_SIZE, 0, nFacets, normal, coordIndex, coord);
+}
+
+// stores nRecords consecutive records, starting with facet number
+// first, in the arrays, which are already sized for all the facets
+void LoaderStl::loadBinaryRecords(const char* record, uint32_t first, uint32_t nRecords, vector<float> &normal, vector<int> &coordIndex, vector<float> &coord) {
+    float* c = coord.data() + 9 * static_cast<size_t>(first);
+    float* n = normal.data() + (_weld ? 3 : 9) * static_cast<size_t>(first);
+    int* ci = coordIndex.data() + 4 * static_cast<size_t>(first);
+
+    // each record has the facet normal, the three vertices, and an
+    // unused uint16 attribute byte count; the floats are little
+    // endian IEEE 754, as the hosts we build for
+    float values[12];
+    for (uint32_t facetNumber = first; facetNumber < first + nRecords; ++facetNumber) {
+        memcpy(values, record, sizeof(values));
+        record += STL_BINARY_RECORD_SIZE;
+        // One normal per vertex, or one per face, as in the ascii files
+        for (int i = (_weld ? 2 : 0); i < 3; ++i) {
+            *(n++) = values[0];
+            *(n++) = values[1];
+            *(n++) = values[2];
+        }
+        memcpy(c, values + 3, 9 * sizeof(float));
+        c += 9;
+        int i0 = 3 * static_cast<int>(facetNumber);
+        *(ci++) = i0;
+        *(ci++) = i0 + 1;
+        *(ci++) = i0 + 2;
+        *(ci++) = -1;
+    }
+}
+
+// cell of the spatial hash used to weld vertices
+struct WeldCell {
+    int64_t x, y, z;
+    bool operator==(const WeldCell& c) const { return x == c.x && y == c.y && z == c.z; }
+};
+
+struct WeldCellHash {
+    size_t operator()(const WeldCell& c) const {
+        uint64_t h = static_cast<uint64_t>(c.x) * 0x9E3779B97F4A7C15ull;
+        h ^= static_cast<uint64_t>(c.y) * 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+        h ^= static_cast<uint64_t>(c.z) * 0x165667B19E3779F9ull + (h << 6) + (h >> 2);
+        return static_cast<size_t>(h);
+    }
+};
+
+// merges the vertices closer than the tolerance (or equal, if the
+// tolerance is zero), keeping the first one found in file order,
+// and updates the coordIndex array accordingly; vertices are hashed
+// into cells of the size of the tolerance, so only the neighboring
+// cells have to be searched
+void LoaderStl::weldVertices(vector<float> &coord, vector<int> &coordIndex, float tolerance) {
+    const int nV = static_cast<int>(coord.size() / 3);
+    const bool exact = !(tolerance > 0.0f);
+    const float tol2 = tolerance * tolerance;
+    const int r = exact ? 0 : 1; // search radius in cells
+
+    unordered_map<WeldCell, int, WeldCellHash> cellFirst; // first welded vertex in cell
+    cellFirst.reserve(static_cast<size_t>(nV) / 4 + 1);
+    vector<int> cellNext;  // next welded vertex in the same cell
+    vector<int> weldedOf(static_cast<size_t>(nV));
+    cellNext.reserve(static_cast<size_t>(nV) / 4 + 1);
+    int nW = 0;
+
+    for (int iV = 0; iV < nV; ++iV) {
+        // adding 0 turns -0 into +0
+        float x = coord[3 * iV] + 0.0f, y = coord[3 * iV + 1] + 0.0f, z = coord[3 * iV + 2] + 0.0f;
+        WeldCell cell;
+        if (exact) {
+            uint32_t bx, by, bz;
+            memcpy(&bx, &x, 4); memcpy(&by, &y, 4); memcpy(&bz, &z, 4);
+            cell = { bx, by, bz };
+        } else {
+            cell = { static_cast<int64_t>(floor(x / tolerance)),
+                     static_cast<int64_t>(floor(y / tolerance)),
+                     static_cast<int64_t>(floor(z / tolerance)) };
+        }
+        int iW = -1;
+        for (int dx = -r; dx <= r && iW < 0; ++dx)
+        for (int dy = -r; dy <= r && iW < 0; ++dy)
+        for (int dz = -r; dz <= r && iW < 0; ++dz) {
+            auto it = cellFirst.find({ cell.x + dx, cell.y + dy, cell.z + dz });
+            if (it == cellFirst.end()) continue;
+            for (int jW = it->second; jW >= 0; jW = cellNext[jW]) {
+                // the welded vertices are already compacted below iV
+                float ex = coord[3 * jW] - x, ey = coord[3 * jW + 1] - y, ez = coord[3 * jW + 2] - z;
+                if (exact ? (ex == 0.0f && ey == 0.0f && ez == 0.0f)
+                          : (ex * ex + ey * ey + ez * ez <= tol2)) {
+                    iW = jW;
+                    break;
+                }
+            }
+        }
+        if (iW < 0) {
+            iW = nW++;
+            coord[3 * iW] = x; coord[3 * iW + 1] = y; coord[3 * iW + 2] = z;
+            auto ins = cellFirst.insert({ cell, iW });
+            cellNext.push_back(ins.second ? -1 : ins.first->second);
+            ins.first->second = iW;
+        }
+        weldedOf[iV] = iW;
+    }
+
+    coord.resize(3 * static_cast<size_t>(nW));
+    coord.shrink_to_fit();
+    for (int& iV : coordIndex) {
+        if (iV >= 0) iV = weldedOf[iV];
+    }
+}
+
+// binary records are read in blocks of this many facets when streaming
+#define STL_STREAM_BLOCK_SIZE 4096
+
+static uint64_t stlFileSize(FILE* fp) {
+#ifdef _WIN32
+    _fseeki64(fp, 0, SEEK_END);
+    int64_t size = _ftelli64(fp);
+#else
+    fseeko(fp, 0, SEEK_END);
+    off_t size = ftello(fp);
+#endif
+    rewind(fp);
+    return (size > 0) ? static_cast<uint64_t>(size) : 0;
+}
+
+// reads the file with a fixed size buffer and sends each facet to the
+// sink, so memory use does not depend on the size of the file; the
+// file is parsed on one thread, and weld mode does not apply
+bool LoaderStl::stream(const char* filename, StlSink& sink) {
+    bool success = false;
+    FILE* fp = nullptr;
+    try {
+
+        if(filename==(char*)0) throw new StrException("filename==null");
+        fp = fopen(filename, "rb");
+        if(fp==(FILE*)0) throw new StrException("unable to open file");
+
+        char header[STL_BINARY_HEADER_SIZE];
+        uint64_t size = stlFileSize(fp);
+        size_t nHeader = fread(header, 1, sizeof(header), fp);
+        rewind(fp);
+
+        float values[12];
+        if (isBinary(header, (nHeader == sizeof(header)) ? size : nHeader)) {
+
+            uint32_t nFacets;
+            memcpy(&nFacets, header + 80, sizeof(uint32_t));
+            fseek(fp, STL_BINARY_HEADER_SIZE, SEEK_SET);
+            vector<char> buffer(STL_STREAM_BLOCK_SIZE * STL_BINARY_RECORD_SIZE);
+            uint32_t facetNumber = 0;
+            while (facetNumber < nFacets) {
+                uint32_t nBlock = nFacets - facetNumber;
+                if (nBlock > STL_STREAM_BLOCK_SIZE) nBlock = STL_STREAM_BLOCK_SIZE;
+                size_t nBytes = static_cast<size_t>(nBlock) * STL_BINARY_RECORD_SIZE;
+                if (fread(buffer.data(), 1, nBytes, fp) != nBytes) {
+                    throw new StrException("Invalid stl file, unexpected end of file");
+                }
+                const char* record = buffer.data();
+                for (uint32_t i = 0; i < nBlock; ++i, record += STL_BINARY_RECORD_SIZE) {
+                    memcpy(values, record, sizeof(values));
+                    sink.facet(values);
+                }
+                facetNumber += nBlock;
+            }
+
+        } else {
+
+            // the next blocks are read while this one is parsed
+            TokenizerReadAhead tkn(fp);
+            if (!(tkn.expecting("solid") && tkn.get())) {
+                throw new StrException("Invalid stl file, expecting solid");
+            }
+            bool empty = true;
+            while (parseFacet(tkn, values)) {
+                sink.facet(values);
+                empty = false;
+            }
+            if (empty) {
+                throw new StrException("Invalid stl file, expecting facet normal");
+            }
+
+        }
+
+        fclose(fp);
+        fp = nullptr;
+        success = sink.end();
+
+    } catch(StrException* e) {
+        success = false;
+        if (fp != nullptr) fclose(fp);
+        fprintf(stderr,"ERROR | %s\n",e->what());
+        delete e;
+    }
+
+    return success;
+}
+
+// true if the first STL_BINARY_HEADER_SIZE bytes of a file can be the
+// start of an ascii file : "solid", text only, and "facet" or
+// "endsolid" after the first end of line; in a binary file the last
+// four bytes are the number of facets, which would be larger than
+// 0x20202020 if they were all text
+static bool isAsciiHeader(const char* header) {
+    if (memcmp(header, "solid", 5) != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < STL_BINARY_HEADER_SIZE; ++i) {
+        unsigned char c = static_cast<unsigned char>(header[i]);
+        if (c < 0x20 && !isStlBlank(header[i])) {
+            return false;
+        }
+        if (c >= 0x7f) {
+            return false;
+        }
+    }
+    const char* end = header + STL_BINARY_HEADER_SIZE;
+    const char* p = static_cast<const char*>(memchr(header, '\n', STL_BINARY_HEADER_SIZE));
+    if (p == nullptr) {
+        return true;
+    }
+    while (p < end && isStlBlank(*p)) ++p;
+    // the keyword may be cut by the end of the header
+    string_view next(p, static_cast<size_t>(end - p));
+    string_view facet("facet"), endsolid("endsolid");
+    return next.substr(0, facet.size()) == facet.substr(0, next.size()) ||
+           next.substr(0, endsolid.size()) == endsolid.substr(0, next.size());
+}
+
+// gzip compressed files (.stl.gz) are inflated while they are parsed;
+// binary files are recognized by the inflated size stored in the gzip
+// trailer, as by the file size for other files, or by their header if
+// the trailer does not match; their records are inflated in blocks
+// straight into the arrays; ascii files are parsed from a
+// TokenizerGzip, on a single thread
+void LoaderStl::loadGzip(const char* filename, vector<float> &normal, vector<int> &coordIndex, vector<float> &coord) {
+    unique_ptr<gzFile_s, int (*)(gzFile)> gz(gzopen(filename, "rb"), gzclose);
+    if (!gz) {
+        throw new StrException("unable to open file");
+    }
+
+    char header[STL_BINARY_HEADER_SIZE];
+    uint32_t nFacets = 0;
+    uint32_t inflatedSize = 0;
+    bool binary = false;
+    if (gzread(gz.get(), header, sizeof(header)) == static_cast<int>(sizeof(header))) {
+        memcpy(&nFacets, header + 80, sizeof(uint32_t));
+        // the trailer only has the size modulo 2^32, and only for files
+        // made of a single gzip member; otherwise the header is checked
+        uint64_t size = STL_BINARY_HEADER_SIZE + static_cast<uint64_t>(nFacets) * STL_BINARY_RECORD_SIZE;
+        binary = (TokenizerGzip::getInflatedSize(filename, inflatedSize) &&
+                  static_cast<uint32_t>(size) == inflatedSize) ||
+                 !isAsciiHeader(header);
+    }
+
+    if (binary) {
+
+        coord.resize(9 * static_cast<size_t>(nFacets));
+        normal.resize((_weld ? 3 : 9) * static_cast<size_t>(nFacets));
+        coordIndex.resize(4 * static_cast<size_t>(nFacets));
+        vector<char> buffer(STL_STREAM_BLOCK_SIZE * STL_BINARY_RECORD_SIZE);
+        uint32_t facetNumber = 0;
+        while (facetNumber < nFacets) {
+            uint32_t nBlock = nFacets - facetNumber;
+            if (nBlock > STL_STREAM_BLOCK_SIZE) nBlock = STL_STREAM_BLOCK_SIZE;
+            int nBytes = static_cast<int>(nBlock * STL_BINARY_RECORD_SIZE);
+            if (gzread(gz.get(), buffer.data(), static_cast<unsigned>(nBytes)) != nBytes) {
+                throw new StrException("Invalid stl file, unexpected end of file");
+            }
+            loadBinaryRecords(buffer.data(), facetNumber, nBlock, normal, coordIndex, coord);
+            facetNumber += nBlock;
+        }
+
+    } else {
+
+        gz.reset();
+        TokenizerGzip tkn(filename);
+        if (!tkn.isOpen()) {
+            throw new StrException("unable to open file");
+        }
+        if (!(tkn.expecting("solid") && tkn.get())) {
+            throw new StrException("Invalid stl file, expecting solid");
+        }
+        parseFaces(tkn, normal, coordIndex, coord);
+        if (coordIndex.empty()) {
+            throw new StrException("Invalid stl file, expecting facet normal");
+        }
+
+    }
+}
+
 bool LoaderStl::load(const char* filename, SceneGraph& wrl) {
     bool success = false;
 
@@ -99,67 +547,63 @@ bool LoaderStl::load(const char* filename, SceneGraph& wrl) {
     wrl.clear();
     wrl.setUrl("");
 
-    FILE* fp = (FILE*)0;
-    Shape* shape = nullptr;
-    Appearance* appearance = nullptr;
-    Material* material = nullptr;
-    IndexedFaceSet* geometry = nullptr;
     try {
 
-        // open the file
+        // map the file
         if(filename==(char*)0) throw new StrException("filename==null");
-        fp = fopen(filename,"r");
-        if(fp==(FILE*)0) throw new StrException("fp==(FILE*)0");
+        // gzip compressed files (.stl.gz) are not mapped
+        unique_ptr<TokenizerMmap> map;
+        const char* data = "";
+        size_t size = 0;
+        const bool gzip = TokenizerGzip::isGzip(filename);
+        if (!gzip) {
+            map.reset(new TokenizerMmap(filename));
+            if(map->isMapped()==false) throw new StrException("unable to map file");
+            data = map->getData();
+            size = map->getSize();
+        }
+        TokenizerBuffer tkn(data, size);
 
         wrl.setUrl(filename);
 
-        // use the io/Tokenizer class to parse the input ascii file
+        // create the scene graph structure :
+        // 1) the SceneGraph should have a single Shape node a child
+        // 2) the Shape node should have an Appearance node in its appearance field
+        // 3) the Appearance node should have a Material node in its material field
+        // 4) the Shape node should have an IndexedFaceSet node in its geometry node
 
-        TokenizerFile tkn(fp);
-        // first token should be "solid"
+        Shape* shape = new Shape();
+        wrl.addChild(shape);
 
-        if(tkn.expecting("solid") && tkn.get()) {
-            string stlName = tkn; // second token should be the solid name
+        Appearance* appearance = new Appearance();
+        shape->setAppearance(appearance);
 
-            shape = new Shape();
-            wrl.addChild(shape);
+        Material* material = new Material();
+        appearance->setMaterial(material);
 
-            appearance = new Appearance();
-            shape->setAppearance(appearance);
+        IndexedFaceSet* geometry = new IndexedFaceSet();
+        shape->setGeometry(geometry);
 
-            material = new Material();
-            appearance->setMaterial(material);
+        vector<float>& normal = geometry->getNormal();
+        vector<int>& coordIndex = geometry->getCoordIndex();
+        vector<float>& coord = geometry->getCoord();
 
-            geometry = new IndexedFaceSet();
-            shape->setGeometry(geometry);
+        if (gzip) {
 
-            vector<float>& normal = geometry->getNormal();
-            vector<int>& coordIndex = geometry->getCoordIndex();
-            vector<float>& coord = geometry->getCoord();
+            loadGzip(filename, normal, coordIndex, coord);
+            success = true;
 
-            uint facetNumber = 0;
-            for (;;) {
-                success = parseFace(tkn, normal, coordIndex, coord, facetNumber);
-                if(!success) {
-                    if (facetNumber > 0) {
-                        break; // We parsed at least one face
-                    } else {
-                        throw StrException("Invalid stl file, expecting facet normal");
-                    }
-                }
-                ++facetNumber;
-            }
+        } else if (isBinary(data, size)) {
+
+            // read the records straight from the mapped file
+            loadBinary(data, normal, coordIndex, coord);
             success = true;
 
-            // create the scene graph structure :
-            // 1) the SceneGraph should have a single Shape node a child
-            // 2) the Shape node should have an Appearance node in its appearance field
-            // 3) the Appearance node should have a Material node in its material field
-            // 4) the Shape node should have an IndexedFaceSet node in its geometry node
+        } else if(tkn.expecting("solid") && tkn.get()) {
 
-            // from the IndexedFaceSet
-            // 5) get references to the coordIndex, coord, and normal arrays
-            // 6) set the normalPerVertex variable to false (i.e., normals per face)
+            // use the io/Tokenizer class to parse the input ascii file
+            // first token should be "solid"
+            string stlName = tkn; // second token should be the solid name
 
             // the file should contain a list of triangles in the following format
 
@@ -171,25 +615,31 @@ bool LoaderStl::load(const char* filename, SceneGraph& wrl) {
             //   endloop
             // endfacet
 
-            // - run an infinite loop to parse all the faces
-            // - write a private method to parse each face within the loop
-            // - the method should return true if successful, and false if not
-            // - if your method returns tru
-            //     update the normal, coord, and coordIndex variables
-            // - if your method returns false
-            //     throw an StrException explaining why the method failed
+            size_t nChunks = numberOfChunks(size);
+            if (nChunks > 1) {
+                parseParallel(data, size, nChunks, normal, coordIndex, coord);
+            } else {
+                parseFaces(tkn, normal, coordIndex, coord);
+            }
+            if (coordIndex.empty()) {
+                throw new StrException("Invalid stl file, expecting facet normal");
+            }
+            success = true;
 
+        } else {
+            throw new StrException("Invalid stl file, expecting solid");
         }
 
-        // close the file (this statement may not be reached)
-        fclose(fp);
+        if (_weld) {
+            weldVertices(coord, coordIndex, _weldTolerance);
+            geometry->setNormalPerVertex(false);
+        }
 
     } catch(StrException* e) {
-        delete shape;
-        delete appearance;
-        delete material;
-        delete geometry;
-        if(fp!=(FILE*)0) fclose(fp);
+        success = false;
+        // the shape owns its fields, and the scene graph the shape
+        wrl.clear();
+        wrl.setUrl("");
         fprintf(stderr,"ERROR | %s\n",e->what());
         delete e;
 
@@ -197,4 +647,3 @@ bool LoaderStl::load(const char* filename, SceneGraph& wrl) {
 
     return success;
 }
-
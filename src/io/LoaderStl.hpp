@@ -39,6 +39,7 @@
 
 #include "Loader.hpp"
 #include "Tokenizer.hpp"
+#include "StlSink.hpp"
 
 #include "wrl/Node.hpp"
 
@@ -47,14 +48,44 @@ class LoaderStl : public Loader {
 private:
 
   const static char* _ext;
+  bool parseFacet(Tokenizer &tkn, float values[12]);
   bool parseFace(Tokenizer &tkn, vector<float> &normal, vector<int> &coordIndex, vector<float> &coord, uint facetNumber);
+  bool parseFaces(Tokenizer &tkn, vector<float> &normal, vector<int> &coordIndex, vector<float> &coord);
+  size_t numberOfChunks(size_t size) const;
+  void parseParallel(const char* data, size_t size, size_t nChunks, vector<float> &normal, vector<int> &coordIndex, vector<float> &coord);
+  static bool isBinary(const char* data, size_t size);
+  void loadBinary(const char* data, vector<float> &normal, vector<int> &coordIndex, vector<float> &coord);
+  void loadBinaryRecords(const char* record, uint32_t first, uint32_t nRecords, vector<float> &normal, vector<int> &coordIndex, vector<float> &coord);
+  void loadGzip(const char* filename, vector<float> &normal, vector<int> &coordIndex, vector<float> &coord);
+  static void weldVertices(vector<float> &coord, vector<int> &coordIndex, float tolerance);
+
+  bool  _weld;
+  float _weldTolerance;
+  int   _nThreads;
 
 public:
 
-  LoaderStl()  {};
+  LoaderStl() : _weld(false), _weldTolerance(0.0f), _nThreads(1) {};
   ~LoaderStl() {};
 
+  // if set, vertices closer than the tolerance are merged into one,
+  // and one normal per face is stored (normalPerVertex FALSE);
+  // otherwise each facet has its own three vertices and normals
+  bool  getWeld() const                { return _weld; }
+  void  setWeld(bool value)            { _weld = value; }
+  float getWeldTolerance() const       { return _weldTolerance; }
+  void  setWeldTolerance(float value)  { _weldTolerance = value; }
+
+  // large ascii files are split into chunks which are parsed on this
+  // many threads; 0 means one thread per core
+  int   getNumberOfThreads() const     { return _nThreads; }
+  void  setNumberOfThreads(int value)  { _nThreads = value; }
+
   bool  load(const char* filename, SceneGraph& wrl);
+
+  // sends the facets to the sink as they are read, without building a
+  // SceneGraph; used to convert files which do not fit in memory
+  bool  stream(const char* filename, StlSink& sink);
   const char* ext() const { return _ext; }
 
 };
@@ -33,8 +33,14 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdio.h>
-#include "TokenizerFile.hpp"
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include "TokenizerBuffer.hpp"
+#include "TokenizerMmap.hpp"
+#include "TokenizerGzip.hpp"
 #include "LoaderWrl.hpp"
+#include "WrlKeyword.hpp"
 #include "StrException.hpp"
 
 #define VRML_HEADER "#VRML V2.0 utf8"
@@ -42,36 +48,63 @@
 const char* LoaderWrl::_ext = "wrl";
 
 bool LoaderWrl::loadSceneGraph(Tokenizer& tkn, SceneGraph& wrl) {
+  DefMap def;
+  return loadNodes(tkn,wrl,def);
+}
+
+// parses top-level nodes until the end of the input
+bool LoaderWrl::loadNodes(Tokenizer& tkn, Group& group, DefMap& def) {
 
   string name    = "";
   bool   success = false;
-  while(tkn.get()) {
-    if(tkn.equals("DEF")) {
+  string_view field;
+  while(success==false && tkn.getView(field)) {
+    switch(wrlKeyword(field)) {
+    case WRL_DEF:
       // if(name!="") throw StrException("DEF name DEF");
       tkn.get("missing token after DEF");
       name = tkn;
-    } else if(tkn.equals("Group")) {
+      break;
+    case WRL_USE: {
+      Node* node = loadUse(tkn,def);
+      if(node->isGroup()==false && node->isShape()==false)
+        throw new StrException("USE of a node which is not a child node");
+      group.addChild(node);
+      name = "";
+      break;
+    }
+    case WRL_NODE_GROUP: {
       Group* g = new Group();
-      wrl.addChild(g);
-      loadGroup(tkn,*g);
+      group.addChild(g);
+      loadGroup(tkn,*g,def);
       g->setName(name);
+      if(name!="") def[name] = g;
       name = "";
-    } else if(tkn.equals("Transform")) {
+      break;
+    }
+    case WRL_NODE_TRANSFORM: {
       Transform* t = new Transform();
-      wrl.addChild(t);
-      loadTransform(tkn,*t);
+      group.addChild(t);
+      loadTransform(tkn,*t,def);
       t->setName(name);
+      if(name!="") def[name] = t;
       name = "";
-    } else if(tkn.equals("Shape")) {
+      break;
+    }
+    case WRL_NODE_SHAPE: {
       Shape* s = new Shape();
-      wrl.addChild(s);
-      loadShape(tkn,*s);
+      group.addChild(s);
+      loadShape(tkn,*s,def);
       s->setName(name);
+      if(name!="") def[name] = s;
       name = "";
-    } else if(tkn.equals("")) {
       break;
-    } else {
-      fprintf(stderr,"tkn=\"%s\"\n",tkn.c_str());
+    }
+    case WRL_EMPTY:
+      success = true;
+      break;
+    default:
+      fprintf(stderr,"tkn=\"%.*s\"\n",(int)field.size(),field.data());
       throw new StrException("unexpected token while parsing Group");
     }
   }
@@ -79,7 +112,137 @@ bool LoaderWrl::loadSceneGraph(Tokenizer& tkn, SceneGraph& wrl) {
   return success;
 }
 
-bool LoaderWrl::loadGroup(Tokenizer& tkn, Group& group) {
+// top-level nodes are grouped into chunks of at least this many bytes
+#define WRL_PARALLEL_CHUNK_SIZE (1<<20)
+
+static inline bool isWrlBlank(const char c) {
+  return (c==' ' || c=='\t' || c=='\n' || c==',' || c=='\015');
+}
+
+class WrlChunk {
+public:
+  size_t begin;
+  size_t end;
+  bool   hasUse; // USE may refer to nodes DEF'ed in previous chunks
+};
+
+// splits the text into chunks of complete top-level nodes, scanning
+// the tokens as Tokenizer does, but only to balance the braces; a
+// node ends at the "}" which closes it, or at the name after a
+// top-level USE
+static void findChunks
+(const char* data, size_t size, size_t chunkSize, vector<WrlChunk>& chunk) {
+  WrlChunk current = { 0, 0, false };
+  int      depth   = 0;
+  bool     use     = false;
+  size_t   i       = 0;
+  while(i<size) {
+    while(i<size && isWrlBlank(data[i])) i++;
+    if(i==size) break;
+    size_t j = i;
+    while(j<size && isWrlBlank(data[j])==false) j++;
+    bool nodeEnd = false;
+    if(data[i]=='#') {
+      // comments extend to the end of the line
+      const char* eol = (const char*)memchr(data+j,'\n',size-j);
+      j = (eol!=(const char*)0)?(size_t)(eol-data)+1:size;
+    } else if(use) {
+      use     = false;
+      nodeEnd = (depth==0);
+    } else if(j-i==1 && data[i]=='{') {
+      depth++;
+    } else if(j-i==1 && data[i]=='}') {
+      nodeEnd = (--depth==0);
+    } else if(j-i==3 && memcmp(data+i,"USE",3)==0) {
+      use = current.hasUse = true;
+    }
+    i = j;
+    if(nodeEnd && i-current.begin>=chunkSize) {
+      current.end = i;
+      chunk.push_back(current);
+      current.begin  = i;
+      current.hasUse = false;
+    }
+  }
+  if(current.begin<size) {
+    current.end = size;
+    chunk.push_back(current);
+  }
+}
+
+// each chunk of nodes is parsed into its own Group by a pool of
+// threads, and the nodes are then attached to the SceneGraph in file
+// order; chunks which contain USE are parsed after the parallel pass,
+// in file order, so that they see the nodes DEF'ed in all the
+// previous chunks, as in the sequential parser
+bool LoaderWrl::loadSceneGraphParallel
+(const char* data, size_t size, SceneGraph& wrl, size_t nThreads) {
+
+  size_t chunkSize = size/(4*nThreads);
+  if(chunkSize<WRL_PARALLEL_CHUNK_SIZE) chunkSize = WRL_PARALLEL_CHUNK_SIZE;
+  vector<WrlChunk> chunk;
+  findChunks(data,size,chunkSize,chunk);
+  size_t nChunks = chunk.size();
+  if(nChunks<2) {
+    TokenizerBuffer tkn(data,size);
+    return loadSceneGraph(tkn,wrl);
+  }
+  if(nThreads>nChunks) nThreads = nChunks;
+
+  vector<Group>         group(nChunks);
+  vector<DefMap>        def(nChunks);
+  vector<StrException*> error(nChunks,(StrException*)0);
+  atomic<size_t>        next(0);
+
+  vector<thread> threads;
+  for(size_t t=0;t<nThreads;t++) {
+    threads.emplace_back([&]() {
+        size_t k;
+        while((k=next++)<nChunks) {
+          if(chunk[k].hasUse) continue;
+          try {
+            TokenizerBuffer
+              tkn(data+chunk[k].begin,chunk[k].end-chunk[k].begin);
+            loadNodes(tkn,group[k],def[k]);
+          } catch(StrException* e) {
+            error[k] = e;
+          }
+        }
+      });
+  }
+  for(thread& t : threads)
+    t.join();
+
+  DefMap defAll;
+  for(size_t k=0;k<nChunks;k++) {
+    if(error[k]==(StrException*)0) {
+      if(chunk[k].hasUse) {
+        try {
+          TokenizerBuffer
+            tkn(data+chunk[k].begin,chunk[k].end-chunk[k].begin);
+          loadNodes(tkn,group[k],defAll);
+        } catch(StrException* e) {
+          error[k] = e;
+        }
+      } else {
+        for(DefMap::iterator i=def[k].begin();i!=def[k].end();i++)
+          defAll[i->first] = i->second;
+      }
+    }
+    if(error[k]!=(StrException*)0) {
+      // report the first error in file order
+      for(size_t j=k+1;j<nChunks;j++)
+        delete error[j];
+      throw error[k];
+    }
+    vector<pNode>& children = group[k].getChildren();
+    for(size_t i=0;i<children.size();i++)
+      wrl.addChild(children[i]);
+  }
+  return true;
+}
+
+bool LoaderWrl::loadGroup(Tokenizer& tkn, Group& group, DefMap& def) {
 
   // Group {
   //   MFNode children    []
@@ -89,29 +252,38 @@ bool LoaderWrl::loadGroup(Tokenizer& tkn, Group& group) {
 
   bool success = false;
   if(tkn.expecting("{")==false) throw new StrException("expecting \"{\"");
-  while(success==false && tkn.get()) {
-    if(tkn.equals("children")) {
-      loadChildren(tkn,group);
-    } else if(tkn.equals("bboxCenter")) {
+  string_view field;
+  while(success==false && tkn.getView(field)) {
+    switch(wrlKeyword(field)) {
+    case WRL_FIELD_CHILDREN:
+      loadChildren(tkn,group,def);
+      break;
+    case WRL_FIELD_BBOX_CENTER: {
       Vec3f v;
       if(tkn.getVec3f(v)==false)
         throw new StrException("expecting Vec3f");
       group.setBBoxCenter(v);
-    } else if(tkn.equals("bboxSize")) {
+      break;
+    }
+    case WRL_FIELD_BBOX_SIZE: {
       Vec3f v;
       if(tkn.getVec3f(v)==false)
         throw new StrException("expecting Vec3f");
       group.setBBoxSize(v);
-    } else if(tkn.equals("}")) {
+      break;
+    }
+    case WRL_CLOSE_BRACE:
       success = true;
-    } else {
+      break;
+    default:
       throw new StrException("unexpected token while parsing Group");
     }
   }
   return success;
 }
 
-bool LoaderWrl::loadTransform(Tokenizer& tkn, Transform& transform) {
+bool LoaderWrl::loadTransform
+(Tokenizer& tkn, Transform& transform, DefMap& def) {
 
   // Transform {
   //   MFNode     children          []
@@ -126,91 +298,130 @@ bool LoaderWrl::loadTransform(Tokenizer& tkn, Transform& transform) {
 
   bool success = false;
   if(tkn.expecting("{")==false) throw new StrException("expecting \"{\"");
-  while(success==false && tkn.get()) {
-    if(tkn.equals("children")) {
-      loadChildren(tkn,transform);
-    } else if(tkn.equals("bboxCenter")) {
+  string_view field;
+  while(success==false && tkn.getView(field)) {
+    switch(wrlKeyword(field)) {
+    case WRL_FIELD_CHILDREN:
+      loadChildren(tkn,transform,def);
+      break;
+    case WRL_FIELD_BBOX_CENTER: {
       Vec3f v;
       if(tkn.getVec3f(v)==false)
         throw new StrException("expecting Vec3f");
       transform.setBBoxCenter(v);
-    } else if(tkn.equals("bboxSize")) {
+      break;
+    }
+    case WRL_FIELD_BBOX_SIZE: {
       Vec3f v;
       if(tkn.getVec3f(v)==false)
         throw new StrException("expecting Vec3f");
       transform.setBBoxCenter(v);
-    } else if(tkn.equals("center")) {
+      break;
+    }
+    case WRL_FIELD_CENTER: {
       Vec3f v;
       if(tkn.getVec3f(v)==false)
         throw new StrException("expecting Vec3f");
       transform.setCenter(v);
-    } else if(tkn.equals("rotation")) {
+      break;
+    }
+    case WRL_FIELD_ROTATION: {
       Vec4f	v;
       if(tkn.getVec4f(v)==false)
         throw new StrException("expecting Vec4f");
       transform.setRotation(v);
-    } else if(tkn.equals("scale")) {
+      break;
+    }
+    case WRL_FIELD_SCALE: {
       Vec3f v;
       if(tkn.getVec3f(v)==false)
         throw new StrException("expecting Vec3f");
       transform.setScale(v);
-    } else if(tkn.equals("scaleOrientation")) {
+      break;
+    }
+    case WRL_FIELD_SCALE_ORIENTATION: {
       // expecting 4 floats
       Vec4f v;
       if(tkn.getVec4f(v)==false)
         throw new StrException("expecting Vec4f");
       transform.setScaleOrientation(v);
-    } else if(tkn.equals("translation")) {
+      break;
+    }
+    case WRL_FIELD_TRANSLATION: {
       // expecting 3 floats
       Vec3f v;
       if(tkn.getVec3f(v)==false)
         throw new StrException("expecting Vec3f");
       transform.setTranslation(v);
-    } else if(tkn.equals("}")) {
+      break;
+    }
+    case WRL_CLOSE_BRACE:
       success = true;
-    } else {
+      break;
+    default:
       throw new StrException("unexpected token while parsing Group");
     }
   }
   return success;
 }
 
-bool LoaderWrl::loadChildren(Tokenizer& tkn, Group& group) {
+bool LoaderWrl::loadChildren(Tokenizer& tkn, Group& group, DefMap& def) {
   string name    = "";
   bool   success = false;
   if(tkn.expecting("[")==false) throw new StrException("expecting \"[\"");
-  while(success==false && tkn.get()) {
-    if(tkn.equals("DEF")) {
+  string_view field;
+  while(success==false && tkn.getView(field)) {
+    switch(wrlKeyword(field)) {
+    case WRL_DEF:
       tkn.get("missing token after DEF");
       name = tkn;
-    } else if(tkn.equals("Group")) {
+      break;
+    case WRL_USE: {
+      Node* node = loadUse(tkn,def);
+      if(node->isGroup()==false && node->isShape()==false)
+        throw new StrException("USE of a node which is not a child node");
+      group.addChild(node);
+      name = "";
+      break;
+    }
+    case WRL_NODE_GROUP: {
       Group* g = new Group();
       group.addChild(g);
-      loadGroup(tkn,*g);
+      loadGroup(tkn,*g,def);
       g->setName(name);
+      if(name!="") def[name] = g;
       name = "";
-    } else if(tkn.equals("Transform")) {
+      break;
+    }
+    case WRL_NODE_TRANSFORM: {
       Transform* t = new Transform();
       group.addChild(t);
-      loadTransform(tkn,*t); 
+      loadTransform(tkn,*t,def); 
       t->setName(name);
+      if(name!="") def[name] = t;
       name = "";
-   } else if(tkn.equals("Shape")) {
+      break;
+    }
+    case WRL_NODE_SHAPE: {
       Shape* s = new Shape();
       group.addChild(s);
-      loadShape(tkn,*s);
+      loadShape(tkn,*s,def);
       s->setName(name);
+      if(name!="") def[name] = s;
       name = "";
-    } else if(tkn.equals("]")) {
+      break;
+    }
+    case WRL_CLOSE_BRACKET:
       success = true;
-    } else {
+      break;
+    default:
       throw new StrException("unexpected token while parsing Group");
     }
   }
   return success;
 }
 
-bool LoaderWrl::loadShape(Tokenizer& tkn, Shape& shape) {
+bool LoaderWrl::loadShape(Tokenizer& tkn, Shape& shape, DefMap& def) {
 
   // Shape {
   //   SFNode appearance NULL
@@ -223,53 +434,83 @@ bool LoaderWrl::loadShape(Tokenizer& tkn, Shape& shape) {
   string name    = "";
   bool   success = false;
   if(tkn.expecting("{")==false) throw new StrException("expecting \"{\"");
-  while(success==false && tkn.get()) {
-    if(tkn.equals("appearance")) {
+  string_view field;
+  while(success==false && tkn.getView(field)) {
+    switch(wrlKeyword(field)) {
+    case WRL_FIELD_APPEARANCE: {
       tkn.get("expecting appearance node");
-      if(tkn.equals("DEF")) {
+      if(wrlKeyword(tkn)==WRL_USE) {
+        Node* node = loadUse(tkn,def);
+        if(node->isAppearance()==false)
+          throw new StrException("USE of a node which is not an Appearance");
+        shape.setAppearance(node);
+        break;
+      }
+      if(wrlKeyword(tkn)==WRL_DEF) {
         tkn.get("missing token after DEF");
         name = tkn;
         tkn.get("missing Appearance token");
       }
-      if(tkn.equals("Appearance")==false)
+      if(wrlKeyword(tkn)!=WRL_NODE_APPEARANCE)
         throw new StrException("expecting Appearance");
       Appearance* a = new Appearance();
       a->setName(name);
+      if(name!="") def[name] = a;
       name = "";
       shape.setAppearance(a);
-      loadAppearance(tkn,*a);
-    } else if(tkn.equals("geometry")) {
+      loadAppearance(tkn,*a,def);
+      break;
+    }
+    case WRL_FIELD_GEOMETRY:
       tkn.get("expecting geometry node");
-      if(tkn.equals("DEF")) {
+      if(wrlKeyword(tkn)==WRL_USE) {
+        Node* node = loadUse(tkn,def);
+        if(node->isIndexedFaceSet()==false &&
+           node->isIndexedLineSet()==false)
+          throw new StrException("USE of a node which is not a geometry node");
+        shape.setGeometry(node);
+        break;
+      }
+      if(wrlKeyword(tkn)==WRL_DEF) {
         tkn.get("missing token after DEF");
         name = tkn;
         tkn.get("missing Appearance token");
       }
-      if(tkn.equals("IndexedFaceSet")) {
+      switch(wrlKeyword(tkn)) {
+      case WRL_NODE_INDEXED_FACE_SET: {
         IndexedFaceSet* ifs = new IndexedFaceSet();
         ifs->setName(name);
+        if(name!="") def[name] = ifs;
         name = "";
         shape.setGeometry(ifs);
         loadIndexedFaceSet(tkn,*ifs);
-      } else if(tkn.equals("IndexedLineSet")) {
+        break;
+      }
+      case WRL_NODE_INDEXED_LINE_SET: {
         IndexedLineSet* ils = new IndexedLineSet();
         ils->setName(name);
+        if(name!="") def[name] = ils;
         name = "";
         shape.setGeometry(ils);
         loadIndexedLineSet(tkn,*ils);
-      } else {
+        break;
+      }
+      default:
         throw new StrException("found unexpected geometry node");
       }
-    } else if(tkn.equals("}")) {
+      break;
+    case WRL_CLOSE_BRACE:
       success = true;
-    } else {
+      break;
+    default:
       throw new StrException("found Appearance field");
     }
   }
   return success;
 }
 
-bool LoaderWrl::loadAppearance(Tokenizer& tkn, Appearance& appearance) {
+bool LoaderWrl::loadAppearance
+(Tokenizer& tkn, Appearance& appearance, DefMap& def) {
 
   // Appearance {
   //   SFNode material NULL
@@ -283,31 +524,51 @@ bool LoaderWrl::loadAppearance(Tokenizer& tkn, Appearance& appearance) {
   string name    = "";
   bool   success = false;
   if(tkn.expecting("{")==false) throw new StrException("expecting \"[\"");
-  while(success==false && tkn.get()) {
-    if(tkn.equals("material")) {
+  string_view field;
+  while(success==false && tkn.getView(field)) {
+    switch(wrlKeyword(field)) {
+    case WRL_FIELD_MATERIAL: {
       tkn.get("expecting material node");
-      if(tkn.equals("DEF")) {
+      if(wrlKeyword(tkn)==WRL_USE) {
+        Node* node = loadUse(tkn,def);
+        if(node->isMaterial()==false)
+          throw new StrException("USE of a node which is not a Material");
+        appearance.setMaterial(node);
+        break;
+      }
+      if(wrlKeyword(tkn)==WRL_DEF) {
         tkn.get("missing token after DEF");
         name = tkn;
         tkn.get("missing Appearance token");
       }
-      if(tkn.equals("Material")==false)
+      if(wrlKeyword(tkn)!=WRL_NODE_MATERIAL)
         throw new StrException("expecting Material");
       Material* m = new Material();
       m->setName(name);
+      if(name!="") def[name] = m;
       name = "";
       appearance.setMaterial(m);
       loadMaterial(tkn,*m);
-    } else if(tkn.equals("texture")) {
+      break;
+    }
+    case WRL_FIELD_TEXTURE:
       tkn.get("expecting Texture node");
-      if(tkn.equals("DEF")) {
+      if(wrlKeyword(tkn)==WRL_USE) {
+        Node* node = loadUse(tkn,def);
+        if(node->isImageTexture()==false)
+          throw new StrException("USE of a node which is not a texture node");
+        appearance.setTexture(node);
+        break;
+      }
+      if(wrlKeyword(tkn)==WRL_DEF) {
         tkn.get("missing token after DEF");
         name = tkn;
         tkn.get("missing Appearance token");
       }
-      if(tkn.equals("ImageTexture")) {
+      if(wrlKeyword(tkn)==WRL_NODE_IMAGE_TEXTURE) {
         ImageTexture* it = new ImageTexture();
         it->setName(name);
+        if(name!="") def[name] = it;
         name = "";
         appearance.setTexture(it);
         loadImageTexture(tkn,*it);
@@ -318,9 +579,11 @@ bool LoaderWrl::loadAppearance(Tokenizer& tkn, Appearance& appearance) {
       } else {
         throw new StrException("found unexpected Texture node");
       }
-    } else if(tkn.equals("}")) {
+      break;
+    case WRL_CLOSE_BRACE:
       success = true;
-    } else {
+      break;
+    default:
       throw new StrException("found unexpected Group field");
     }
   }
@@ -340,40 +603,55 @@ bool LoaderWrl::loadMaterial(Tokenizer& tkn, Material& material) {
 
   bool success = false;
   if(tkn.expecting("{")==false) throw new StrException("expecting \"{\"");
-  while(success==false && tkn.get()) {
-    if(tkn.equals("ambientIntensity")) {
+  string_view field;
+  while(success==false && tkn.getView(field)) {
+    switch(wrlKeyword(field)) {
+    case WRL_FIELD_AMBIENT_INTENSITY: {
       float f;
       if(tkn.getFloat(f)==false)
         throw new StrException("expecting float");
       material.setAmbientIntensity(f);
-    } else if(tkn.equals("diffuseColor")) {
+      break;
+    }
+    case WRL_FIELD_DIFFUSE_COLOR: {
       Color c;
       if(tkn.getColor(c)==false)
         throw new StrException("expecting Color");
       material.setDiffuseColor(c);
-    } else if(tkn.equals("emissiveColor")) {
+      break;
+    }
+    case WRL_FIELD_EMISSIVE_COLOR: {
       Color c;
       if(tkn.getColor(c)==false)
         throw new StrException("expecting Color");
       material.setEmissiveColor(c);
-    } else if(tkn.equals("shininess")) {
+      break;
+    }
+    case WRL_FIELD_SHININESS: {
       float f;
       if(tkn.getFloat(f)==false)
         throw new StrException("expecting float");
       material.setShininess(f);
-    } else if(tkn.equals("specularColor")) {
+      break;
+    }
+    case WRL_FIELD_SPECULAR_COLOR: {
       Color c;
       if(tkn.getColor(c)==false)
         throw new StrException("expecting Color");
       material.setSpecularColor(c);
-    } else if(tkn.equals("transparency")) {
+      break;
+    }
+    case WRL_FIELD_TRANSPARENCY: {
       float f;
       if(tkn.getFloat(f)==false)
         throw new StrException("expecting float");
       material.setTransparency(f);
-    } else if(tkn.equals("}")) {
+      break;
+    }
+    case WRL_CLOSE_BRACE:
       success = true;
-    } else {
+      break;
+    default:
       throw new StrException("found unexpected Appearance field");
     }
   }
@@ -391,24 +669,33 @@ bool LoaderWrl::loadImageTexture(Tokenizer& tkn, ImageTexture& imageTexture) {
 
   bool success = false;
   if(tkn.expecting("{")==false) throw new StrException("expecting \"{\"");
-  while(success==false && tkn.get()) {
-    if(tkn.equals("url")) {
+  string_view field;
+  while(success==false && tkn.getView(field)) {
+    switch(wrlKeyword(field)) {
+    case WRL_FIELD_URL: {
       vector<string>& _url = imageTexture.getUrl();
       if(loadVecString(tkn,_url)==false)
         throw new StrException("loading vector<string>");
-    } else if(tkn.equals("repeatS")) {
+      break;
+    }
+    case WRL_FIELD_REPEAT_S: {
       bool b;
       if(tkn.getBool(b)==false)
         throw new StrException("expecting boolean value");
       imageTexture.setRepeatS(b);
-    } else if(tkn.equals("repeatT")) {
+      break;
+    }
+    case WRL_FIELD_REPEAT_T: {
       bool b;
       if(tkn.getBool(b)==false)
         throw new StrException("expecting boolean value");
       imageTexture.setRepeatT(b);
-    } else if(tkn.equals("}")) {
+      break;
+    }
+    case WRL_CLOSE_BRACE:
       success = true;
-    } else {
+      break;
+    default:
       throw new StrException("found unexpected Appearance field");
     }
   }
@@ -436,8 +723,10 @@ bool LoaderWrl::loadIndexedFaceSet(Tokenizer& tkn, IndexedFaceSet& ifs) {
 
   bool success = false;
   if(tkn.expecting("{")==false) throw new StrException("expecting \"{\"");
-  while(success==false && tkn.get()) {
-    if(tkn.equals("color")) {
+  string_view field;
+  while(success==false && tkn.getView(field)) {
+    switch(wrlKeyword(field)) {
+    case WRL_FIELD_COLOR: {
       //   SFNode  
       vector<float>& _color = ifs.getColor();
 
@@ -454,7 +743,9 @@ bool LoaderWrl::loadIndexedFaceSet(Tokenizer& tkn, IndexedFaceSet& ifs) {
       if(tkn.expecting("}")==false)
         throw new StrException("expecting \"}\"");
 
-    } else if(tkn.equals("coord")) {
+      break;
+    }
+    case WRL_FIELD_COORD: {
       //   SFNode  
       vector<float>& _coord = ifs.getCoord();
 
@@ -471,7 +762,9 @@ bool LoaderWrl::loadIndexedFaceSet(Tokenizer& tkn, IndexedFaceSet& ifs) {
       if(tkn.expecting("}")==false)
         throw new StrException("expecting \"}\"");
 
-    } else if(tkn.equals("normal")) {
+      break;
+    }
+    case WRL_FIELD_NORMAL: {
       //   SFNode  
       vector<float>& _normal = ifs.getNormal();
 
@@ -488,7 +781,9 @@ bool LoaderWrl::loadIndexedFaceSet(Tokenizer& tkn, IndexedFaceSet& ifs) {
       if(tkn.expecting("}")==false)
         throw new StrException("expecting \"}\"");
 
-    } else if(tkn.equals("texCoord")) {
+      break;
+    }
+    case WRL_FIELD_TEX_COORD: {
       //   SFNode  
       vector<float>& _texCoord = ifs.getTexCoord();
 
@@ -505,59 +800,82 @@ bool LoaderWrl::loadIndexedFaceSet(Tokenizer& tkn, IndexedFaceSet& ifs) {
       if(tkn.expecting("}")==false)
         throw new StrException("expecting \"}\"");
 
-    } else if(tkn.equals("ccw")) {
+      break;
+    }
+    case WRL_FIELD_CCW: {
       //   SFBool
       bool& _ccw = ifs.getCcw();
       if(tkn.getBool(_ccw)==false)
         throw new StrException("loading IndexedFaceSet ccw field");  
-    } else if(tkn.equals("colorIndex")) {
+      break;
+    }
+    case WRL_FIELD_COLOR_INDEX: {
       //   MFInt32 
       vector<int>& _colorIndex = ifs.getColorIndex();
       if(loadVecInt(tkn,_colorIndex)==false)
         throw new StrException("loading IndexedFaceSet colorIndex field");
-    } else if(tkn.equals("colorPerVertex")) {
+      break;
+    }
+    case WRL_FIELD_COLOR_PER_VERTEX: {
       //   SFBool
       bool& _colorPerVertex = ifs.getColorPerVertex();
         if(tkn.getBool(_colorPerVertex)==false)
         throw new StrException("loading IndexedFaceSet colorPerVertex field");
-    } else if(tkn.equals("convex")) {
+      break;
+    }
+    case WRL_FIELD_CONVEX: {
       //   SFBool
       bool& _convex = ifs.getConvex();  
       if(tkn.getBool(_convex)==false)
         throw new StrException("loading IndexedFaceSet convex field");
-    } else if(tkn.equals("coordIndex")) {
+      break;
+    }
+    case WRL_FIELD_COORD_INDEX: {
       //   MFInt32 
       vector<int>& _coordIndex = ifs.getCoordIndex();
       if(loadVecInt(tkn,_coordIndex)==false)
         throw new StrException("loading IndexedFaceSet coordIndex field");
-    } else if(tkn.equals("creaseAngle")) {
+      break;
+    }
+    case WRL_FIELD_CREASE_ANGLE: {
       //   SFFloat
       float& _creaseAngle = ifs.getCreaseangle();
       if(tkn.getFloat(_creaseAngle)==false)
         throw new StrException("loading IndexedFaceSet creaseAngle value");
-    } else if(tkn.equals("normalIndex")) {
+      break;
+    }
+    case WRL_FIELD_NORMAL_INDEX: {
       //   MFInt32 
       vector<int>& _normalIndex = ifs.getNormalIndex();
       if(loadVecInt(tkn,_normalIndex)==false)
         throw new StrException("loading IndexedFaceSet normalIndex field");
-    } else if(tkn.equals("normalPerVertex")) {
+      break;
+    }
+    case WRL_FIELD_NORMAL_PER_VERTEX: {
       //   SFBool
       bool& _normalPerVertex = ifs.getNormalPerVertex();
       if(tkn.getBool(_normalPerVertex)==false)
         throw new StrException("loading IndexedFaceSet normalPerVertex field");
-    } else if(tkn.equals("solid")) {
+      break;
+    }
+    case WRL_FIELD_SOLID: {
       //   SFBool
       bool& _solid = ifs.getSolid();  
       if(tkn.getBool(_solid)==false)
         throw new StrException("loading IndexedFaceSet solid field");
-    } else if(tkn.equals("texCoordIndex")) {
+      break;
+    }
+    case WRL_FIELD_TEX_COORD_INDEX: {
       //   MFInt32 
       vector<int>& _texCoordIndex = ifs.getTexCoordIndex();
       if(loadVecInt(tkn,_texCoordIndex)==false)
         throw new StrException("loading IndexedFaceSet texCoordIndex field");
-    } else if(tkn.equals("}")) {
+      break;
+    }
+    case WRL_CLOSE_BRACE:
       success = true;
-    } else {
+      break;
+    default:
       throw new StrException("found unexpected IndexedFaceSet field");
     }
   }
@@ -576,8 +894,10 @@ bool LoaderWrl::loadIndexedLineSet(Tokenizer& tkn, IndexedLineSet& ifs) {
 
   bool success = false;
   if(tkn.expecting("{")==false) throw new StrException("expecting \"{\"");
-  while(success==false && tkn.get()) {
-    if(tkn.equals("color")) {
+  string_view field;
+  while(success==false && tkn.getView(field)) {
+    switch(wrlKeyword(field)) {
+    case WRL_FIELD_COLOR: {
       //   SFNode  
       vector<float>& _color = ifs.getColor();
 
@@ -594,7 +914,9 @@ bool LoaderWrl::loadIndexedLineSet(Tokenizer& tkn, IndexedLineSet& ifs) {
       if(tkn.expecting("}")==false)
         throw new StrException("expecting \"}\"");
 
-    } else if(tkn.equals("coord")) {
+      break;
+    }
+    case WRL_FIELD_COORD: {
       //   SFNode  
       vector<float>& _coord = ifs.getCoord();
 
@@ -611,42 +933,57 @@ bool LoaderWrl::loadIndexedLineSet(Tokenizer& tkn, IndexedLineSet& ifs) {
       if(tkn.expecting("}")==false)
         throw new StrException("expecting \"}\"");
 
-    } else if(tkn.equals("colorIndex")) {
+      break;
+    }
+    case WRL_FIELD_COLOR_INDEX: {
       //   MFInt32 
       vector<int>& _colorIndex = ifs.getColorIndex();
       if(loadVecInt(tkn,_colorIndex)==false)
         throw new StrException("loading IndexedLineSet colorIndex field");
-    } else if(tkn.equals("colorPerVertex")) {
+      break;
+    }
+    case WRL_FIELD_COLOR_PER_VERTEX: {
       //   SFBool
       bool& _colorPerVertex = ifs.getColorPerVertex();
         if(tkn.getBool(_colorPerVertex)==false)
         throw new StrException("loading IndexedLineSet colorPerVertex field");
-    } else if(tkn.equals("coordIndex")) {
+      break;
+    }
+    case WRL_FIELD_COORD_INDEX: {
       //   MFInt32 
       vector<int>& _coordIndex = ifs.getCoordIndex();
       if(loadVecInt(tkn,_coordIndex)==false)
         throw new StrException("loading IndexedLineSet coordIndex field");
-    } else if(tkn.equals("}")) {
+      break;
+    }
+    case WRL_CLOSE_BRACE:
       success = true;
-    } else {
+      break;
+    default:
       throw new StrException("found unexpected IndexedLineSet field");
     }
   }
   return success;
 }
 
+Node* LoaderWrl::loadUse(Tokenizer& tkn, DefMap& def) {
+  tkn.get("missing token after USE");
+  DefMap::iterator i = def.find(tkn);
+  if(i==def.end())
+    throw new StrException("USE of undefined node \""+string(tkn)+"\"");
+  return i->second;
+}
+
 bool LoaderWrl::loadVecFloat(Tokenizer&tkn,vector<float>& vec) {
   bool success = false;
   if(tkn.expecting("[")==false) throw new StrException("expecting \"[\"");
   float value;
-  while(success==false && tkn.get()) {
-    if(tkn.equals("]")) {
-      success = true; // done
-    } else if(sscanf(tkn.c_str(),"%f",&value)==1) {
-      vec.push_back(value);
-    } else {
-      throw new StrException("expecting int value");
-    }
+  while(tkn.getFloat(value))
+    vec.push_back(value);
+  if(tkn.equals("]")) {
+    success = true; // done
+  } else if(tkn.length()>0) {
+    throw new StrException("expecting float value");
   }
 
   return success;
@@ -656,14 +993,12 @@ bool LoaderWrl::loadVecInt(Tokenizer&tkn,vector<int>& vec) {
   bool success = false;
   if(tkn.expecting("[")==false) throw new StrException("expecting \"[\"");
   int value;
-  while(success==false && tkn.get()) {
-    if(tkn.equals("]")) {
-      success = true; // done
-    } else if(sscanf(tkn.c_str(),"%d",&value)==1) {
-      vec.push_back(value);
-    } else {
-      throw new StrException("expecting int value");
-    }
+  while(tkn.getInt(value))
+    vec.push_back(value);
+  if(tkn.equals("]")) {
+    success = true; // done
+  } else if(tkn.length()>0) {
+    throw new StrException("expecting int value");
   }
   return success;
 }
@@ -689,42 +1024,63 @@ bool LoaderWrl::loadVecString(Tokenizer&tkn,vector<string>& vec) {
   return success;
 }
 
+void LoaderWrl::loadHeader(Tokenizer& tkn, SceneGraph& wrl, const char* filename) {
+
+  // clear the container
+  wrl.clear();
+  wrl.setUrl(filename);
+
+  // read and check header line
+  tkn.getline();
+  if(tkn.compare(0,15,VRML_HEADER)!=0) throw new StrException("header!=VRM_HEADER");
+}
+
+bool LoaderWrl::loadFile(Tokenizer& tkn, SceneGraph& wrl, const char* filename) {
+  loadHeader(tkn,wrl,filename);
+  // start parsing
+  return loadSceneGraph(tkn,wrl);
+}
+
+bool LoaderWrl::loadFile(TokenizerMmap& tkn, SceneGraph& wrl, const char* filename) {
+  loadHeader(tkn,wrl,filename);
+  size_t nThreads =
+    (_nThreads>0)?(size_t)_nThreads:(size_t)thread::hardware_concurrency();
+  if(nThreads<=1) return loadSceneGraph(tkn,wrl);
+  // the nodes start on the line after the header
+  const char* data   = tkn.getData();
+  size_t      size   = tkn.getSize();
+  const char* eol    = (const char*)memchr(data,'\n',size);
+  size_t      offset = (eol!=(const char*)0)?(size_t)(eol-data)+1:size;
+  return loadSceneGraphParallel(data+offset,size-offset,wrl,nThreads);
+}
+
 bool LoaderWrl::load(const char* filename, SceneGraph& wrl) {
   bool success = false;
 
-  FILE* fp = (FILE*)0;
   try {
 
-    // open the file
     if(filename==(char*)0) throw new StrException("filename==null");
-    fp = fopen(filename,"r");
-    if(fp==(FILE*)0) throw new StrException("fp==(FILE*)0");
 
-    // clear the container
-    wrl.clear();
-    wrl.setUrl(filename);
-
-    // read and check header line
-    char header[16];
-    // memset(header,'\0',16);
-    for(int i=0;i<16;i++) header[i] = '\0';
-    fscanf(fp,"%15c",header);
-    if(string(header)!=VRML_HEADER) throw new StrException("header!=VRM_HEADER");
-
-    // create a Tokenizer and start parsing
-    TokenizerFile tkn(fp);
-    loadSceneGraph(tkn,wrl);
+    if(TokenizerGzip::isGzip(filename)) {
+      // .wrz and .wrl.gz files are inflated while they are parsed
+      TokenizerGzip tkn(filename);
+      if(tkn.isOpen()==false) throw new StrException("unable to open file");
+      loadFile(tkn,wrl,filename);
+    } else {
+      // map the file
+      TokenizerMmap tkn(filename);
+      if(tkn.isMapped()==false) throw new StrException("unable to map file");
+      loadFile(tkn,wrl,filename);
+    }
 
     // will be done later
     // wrl.updateBBox();
     
     // if we have reached this point we have succeeded
-    fclose(fp);
     success = true;
 
   } catch(StrException* e) { 
 
-    if(fp!=(FILE*)0) fclose(fp);
     fprintf(stderr,"ERROR | %s\n",e->what());
     delete e;
     wrl.clear();
@@ -734,4 +1090,3 @@ bool LoaderWrl::load(const char* filename, SceneGraph& wrl) {
 
   return success;
 }
-
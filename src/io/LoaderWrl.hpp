@@ -35,6 +35,7 @@
 #ifndef _LOADER_WRL_HPP_
 #define _LOADER_WRL_HPP_
 
+#include <map>
 #include "Loader.hpp"
 #include "Tokenizer.hpp"
 #include <wrl/Transform.hpp>
@@ -45,28 +46,48 @@
 #include <wrl/IndexedFaceSet.hpp>
 #include <wrl/IndexedLineSet.hpp>
 
+class TokenizerMmap;
+
 class LoaderWrl : public Loader {
 
 private:
 
   const static char* _ext;
 
+  int _nThreads;
+
 public:
 
-  LoaderWrl()  {};
+  LoaderWrl():_nThreads(1) {};
   ~LoaderWrl() {};
 
   bool  load(const char* filename, SceneGraph& wrl);
   const char* ext() const { return _ext; }
 
+  // uncompressed files with many top-level nodes are split into chunks
+  // of complete nodes, which are parsed on this many threads; 0 means
+  // one thread per core
+  int   getNumberOfThreads() const    { return _nThreads; }
+  void  setNumberOfThreads(int value) { _nThreads = value; }
+
 private:
 
+  // nodes named with DEF so far, instanced by USE
+  typedef map<string,Node*> DefMap;
+
+  void loadHeader(Tokenizer& tkn, SceneGraph& wrl, const char* filename);
+  bool loadFile(Tokenizer& tkn, SceneGraph& wrl, const char* filename);
+  bool loadFile(TokenizerMmap& tkn, SceneGraph& wrl, const char* filename);
   bool loadSceneGraph(Tokenizer& tkn, SceneGraph& wrl);
-  bool loadGroup(Tokenizer& tkn, Group& group);
-  bool loadTransform(Tokenizer& tkn, Transform& transform);
-  bool loadChildren(Tokenizer& tkn, Group& group);
-  bool loadShape(Tokenizer& tkn, Shape& transform);
-  bool loadAppearance(Tokenizer& tkn, Appearance& appearance);
+  bool loadSceneGraphParallel
+  (const char* data, size_t size, SceneGraph& wrl, size_t nThreads);
+  bool loadNodes(Tokenizer& tkn, Group& group, DefMap& def);
+  bool loadGroup(Tokenizer& tkn, Group& group, DefMap& def);
+  bool loadTransform(Tokenizer& tkn, Transform& transform, DefMap& def);
+  bool loadChildren(Tokenizer& tkn, Group& group, DefMap& def);
+  bool loadShape(Tokenizer& tkn, Shape& transform, DefMap& def);
+  bool loadAppearance(Tokenizer& tkn, Appearance& appearance, DefMap& def);
+  Node* loadUse(Tokenizer& tkn, DefMap& def);
   bool loadMaterial(Tokenizer& tkn, Material& material);
   bool loadImageTexture(Tokenizer& tkn, ImageTexture& imageTexture);
   bool loadIndexedFaceSet(Tokenizer& tkn, IndexedFaceSet& ifs);
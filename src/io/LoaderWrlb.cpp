@@ -0,0 +1,373 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// LoaderWrlb.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <stdint.h>
+#include <string.h>
+#include "LoaderWrlb.hpp"
+#include "TokenizerMmap.hpp"
+#include "StrException.hpp"
+#include "Wrlb.hpp"
+
+const char* LoaderWrlb::_ext = "wrlb";
+
+//////////////////////////////////////////////////////////////////////
+// bounds checked sequential access to the mapped file
+
+class WrlbReader {
+
+public:
+
+  WrlbReader(const char* data, const size_t size):
+    _data(data),_size(size),_pos(0) {
+  }
+
+  const char* take(const size_t n) {
+    if(n>_size-_pos) throw new StrException("unexpected end of file");
+    const char* p = _data+_pos;
+    _pos += n;
+    return p;
+  }
+
+  void align(const size_t alignment) {
+    take((alignment-_pos%alignment)%alignment);
+  }
+
+  uint32_t getUInt() {
+    uint32_t value;
+    memcpy(&value,take(sizeof(value)),sizeof(value));
+    return value;
+  }
+
+  float getFloat() {
+    float value;
+    memcpy(&value,take(sizeof(value)),sizeof(value));
+    return value;
+  }
+
+  Vec3f getVec3f() {
+    float x = getFloat(), y = getFloat(), z = getFloat();
+    return Vec3f(x,y,z);
+  }
+
+  Vec4f getVec4f() {
+    float x = getFloat(), y = getFloat(), z = getFloat(), w = getFloat();
+    return Vec4f(x,y,z,w);
+  }
+
+  string getString() {
+    uint32_t n = getUInt();
+    string str(take(n),n);
+    align(4);
+    return str;
+  }
+
+  // arrays start at 8 byte boundaries of a page aligned mapping
+  template<class T> void getVec(vector<T>& vec) {
+    align(8);
+    uint64_t n;
+    memcpy(&n,take(sizeof(n)),sizeof(n));
+    if(n>(_size-_pos)/sizeof(T))
+      throw new StrException("unexpected end of file");
+    const T* p = (const T*)take(n*sizeof(T));
+    vec.assign(p,p+n);
+  }
+
+  // the nodes are numbered in the order in which they are read, as
+  // in SaverWrlb, so that WRLB_USE records can refer to them; as in
+  // LoaderWrl a node can only be used after it has been fully loaded
+  uint32_t reserveNode() {
+    _node.push_back((Node*)0);
+    return static_cast<uint32_t>(_node.size()-1);
+  }
+
+  void setNode(const uint32_t index, Node* node) {
+    _node[index] = node;
+  }
+
+  Node* getNode() {
+    uint32_t index = getUInt();
+    if(index>=_node.size() || _node[index]==(Node*)0)
+      throw new StrException("USE of an undefined node");
+    return _node[index];
+  }
+
+private:
+
+  const char*   _data;
+  size_t        _size;
+  size_t        _pos;
+  vector<Node*> _node;
+};
+
+//////////////////////////////////////////////////////////////////////
+void LoaderWrlb::loadChildren(WrlbReader& rd, Group& group) {
+  uint32_t nChildren = rd.getUInt();
+  for(uint32_t i=0;i<nChildren;i++) {
+    uint32_t type = rd.getUInt();
+    if(type==WRLB_USE) {
+      Node* node = rd.getNode();
+      if(node->isGroup()==false && node->isShape()==false)
+        throw new StrException("USE of a node which is not a child node");
+      group.addChild(node);
+      continue;
+    }
+    string   name = rd.getString();
+    if(type==WRLB_GROUP) {
+      Group* g = new Group();
+      g->setName(name);
+      group.addChild(g);
+      uint32_t index = rd.reserveNode();
+      loadGroup(rd,*g);
+      rd.setNode(index,g);
+    } else if(type==WRLB_TRANSFORM) {
+      Transform* t = new Transform();
+      t->setName(name);
+      group.addChild(t);
+      uint32_t index = rd.reserveNode();
+      loadTransform(rd,*t);
+      rd.setNode(index,t);
+    } else if(type==WRLB_SHAPE) {
+      Shape* s = new Shape();
+      s->setName(name);
+      group.addChild(s);
+      uint32_t index = rd.reserveNode();
+      loadShape(rd,*s);
+      rd.setNode(index,s);
+    } else {
+      throw new StrException("unexpected child node type");
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+void LoaderWrlb::loadGroup(WrlbReader& rd, Group& group) {
+  Vec3f bboxCenter = rd.getVec3f();
+  Vec3f bboxSize   = rd.getVec3f();
+  group.setBBoxCenter(bboxCenter);
+  group.setBBoxSize(bboxSize);
+  loadChildren(rd,group);
+}
+
+//////////////////////////////////////////////////////////////////////
+void LoaderWrlb::loadTransform(WrlbReader& rd, Transform& transform) {
+  Vec3f center           = rd.getVec3f();
+  Vec4f rotation         = rd.getVec4f();
+  Vec3f scale            = rd.getVec3f();
+  Vec4f scaleOrientation = rd.getVec4f();
+  Vec3f translation      = rd.getVec3f();
+  transform.setCenter(center);
+  transform.setRotation(rotation);
+  transform.setScale(scale);
+  transform.setScaleOrientation(scaleOrientation);
+  transform.setTranslation(translation);
+  loadGroup(rd,transform);
+}
+
+//////////////////////////////////////////////////////////////////////
+void LoaderWrlb::loadShape(WrlbReader& rd, Shape& shape) {
+  uint32_t type = rd.getUInt();
+  if(type==WRLB_USE) {
+    Node* node = rd.getNode();
+    if(node->isAppearance()==false)
+      throw new StrException("expecting Appearance");
+    shape.setAppearance(node);
+  } else if(type==WRLB_APPEARANCE) {
+    Appearance* a = new Appearance();
+    a->setName(rd.getString());
+    shape.setAppearance(a);
+    uint32_t index = rd.reserveNode();
+    loadAppearance(rd,*a);
+    rd.setNode(index,a);
+  } else if(type!=WRLB_NULL) {
+    throw new StrException("expecting Appearance");
+  }
+  type = rd.getUInt();
+  if(type==WRLB_USE) {
+    Node* node = rd.getNode();
+    if(node->isIndexedFaceSet()==false && node->isIndexedLineSet()==false)
+      throw new StrException("found unexpected geometry node");
+    shape.setGeometry(node);
+  } else if(type==WRLB_INDEXED_FACE_SET) {
+    IndexedFaceSet* ifs = new IndexedFaceSet();
+    ifs->setName(rd.getString());
+    shape.setGeometry(ifs);
+    uint32_t index = rd.reserveNode();
+    loadIndexedFaceSet(rd,*ifs);
+    rd.setNode(index,ifs);
+  } else if(type==WRLB_INDEXED_LINE_SET) {
+    IndexedLineSet* ils = new IndexedLineSet();
+    ils->setName(rd.getString());
+    shape.setGeometry(ils);
+    uint32_t index = rd.reserveNode();
+    loadIndexedLineSet(rd,*ils);
+    rd.setNode(index,ils);
+  } else if(type!=WRLB_NULL) {
+    throw new StrException("found unexpected geometry node");
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+void LoaderWrlb::loadAppearance(WrlbReader& rd, Appearance& appearance) {
+  uint32_t type = rd.getUInt();
+  if(type==WRLB_USE) {
+    Node* node = rd.getNode();
+    if(node->isMaterial()==false)
+      throw new StrException("expecting Material");
+    appearance.setMaterial(node);
+  } else if(type==WRLB_MATERIAL) {
+    Material* m = new Material();
+    m->setName(rd.getString());
+    appearance.setMaterial(m);
+    uint32_t index = rd.reserveNode();
+    loadMaterial(rd,*m);
+    rd.setNode(index,m);
+  } else if(type!=WRLB_NULL) {
+    throw new StrException("expecting Material");
+  }
+  type = rd.getUInt();
+  if(type==WRLB_USE) {
+    Node* node = rd.getNode();
+    if(node->isImageTexture()==false)
+      throw new StrException("expecting ImageTexture");
+    appearance.setTexture(node);
+  } else if(type==WRLB_IMAGE_TEXTURE) {
+    ImageTexture* t = new ImageTexture();
+    t->setName(rd.getString());
+    appearance.setTexture(t);
+    uint32_t index = rd.reserveNode();
+    loadImageTexture(rd,*t);
+    rd.setNode(index,t);
+  } else if(type!=WRLB_NULL) {
+    throw new StrException("expecting ImageTexture");
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+void LoaderWrlb::loadMaterial(WrlbReader& rd, Material& material) {
+  material.setAmbientIntensity(rd.getFloat());
+  Vec3f d = rd.getVec3f();
+  Color diffuseColor(d.x,d.y,d.z);
+  material.setDiffuseColor(diffuseColor);
+  Vec3f e = rd.getVec3f();
+  Color emissiveColor(e.x,e.y,e.z);
+  material.setEmissiveColor(emissiveColor);
+  material.setShininess(rd.getFloat());
+  Vec3f s = rd.getVec3f();
+  Color specularColor(s.x,s.y,s.z);
+  material.setSpecularColor(specularColor);
+  material.setTransparency(rd.getFloat());
+}
+
+//////////////////////////////////////////////////////////////////////
+void LoaderWrlb::loadImageTexture
+(WrlbReader& rd, ImageTexture& imageTexture) {
+  imageTexture.setRepeatS(rd.getUInt()!=0);
+  imageTexture.setRepeatT(rd.getUInt()!=0);
+  uint32_t nUrl = rd.getUInt();
+  for(uint32_t i=0;i<nUrl;i++)
+    imageTexture.adToUrl(rd.getString());
+}
+
+//////////////////////////////////////////////////////////////////////
+void LoaderWrlb::loadIndexedFaceSet(WrlbReader& rd, IndexedFaceSet& ifs) {
+  uint32_t flags = rd.getUInt();
+  ifs.getCcw()             = (flags&WRLB_CCW)!=0;
+  ifs.getConvex()          = (flags&WRLB_CONVEX)!=0;
+  ifs.getSolid()           = (flags&WRLB_SOLID)!=0;
+  ifs.getNormalPerVertex() = (flags&WRLB_NORMAL_PER_VERTEX)!=0;
+  ifs.getColorPerVertex()  = (flags&WRLB_COLOR_PER_VERTEX)!=0;
+  ifs.getCreaseangle()     = rd.getFloat();
+  rd.getVec(ifs.getCoord());
+  rd.getVec(ifs.getCoordIndex());
+  rd.getVec(ifs.getNormal());
+  rd.getVec(ifs.getNormalIndex());
+  rd.getVec(ifs.getColor());
+  rd.getVec(ifs.getColorIndex());
+  rd.getVec(ifs.getTexCoord());
+  rd.getVec(ifs.getTexCoordIndex());
+}
+
+//////////////////////////////////////////////////////////////////////
+void LoaderWrlb::loadIndexedLineSet(WrlbReader& rd, IndexedLineSet& ils) {
+  ils.getColorPerVertex() = (rd.getUInt()!=0);
+  rd.getVec(ils.getCoord());
+  rd.getVec(ils.getCoordIndex());
+  rd.getVec(ils.getColor());
+  rd.getVec(ils.getColorIndex());
+}
+
+//////////////////////////////////////////////////////////////////////
+bool LoaderWrlb::load(const char* filename, SceneGraph& wrl) {
+  bool success = false;
+
+  try {
+
+    // map the file
+    if(filename==(char*)0) throw new StrException("filename==null");
+    TokenizerMmap tkn(filename);
+    if(tkn.isMapped()==false) throw new StrException("unable to map file");
+
+    // clear the container
+    wrl.clear();
+    wrl.setUrl(filename);
+
+    // check header
+    WrlbReader rd(tkn.getData(),tkn.getSize());
+    if(memcmp(rd.take(4),WRLB_MAGIC,4)!=0)
+      throw new StrException("not a wrlb file");
+    // version 1 files are read as well, since they only lack WRLB_USE
+    uint32_t version = rd.getUInt();
+    if(version<1 || version>WRLB_VERSION)
+      throw new StrException("unsupported wrlb version");
+    if(rd.getUInt()!=WRLB_BYTE_ORDER)
+      throw new StrException("wrlb file written with a different byte order");
+
+    wrl.setName(rd.getString());
+    loadChildren(rd,wrl);
+
+    // if we have reached this point we have succeeded
+    success = true;
+
+  } catch(StrException* e) { 
+
+    fprintf(stderr,"ERROR | %s\n",e->what());
+    delete e;
+    wrl.clear();
+    wrl.setUrl("");
+
+  }
+
+  return success;
+}
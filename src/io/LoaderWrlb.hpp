@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// LoaderWrlb.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef _LOADER_WRLB_HPP_
+#define _LOADER_WRLB_HPP_
+
+#include "Loader.hpp"
+#include <wrl/Transform.hpp>
+#include <wrl/Shape.hpp>
+#include <wrl/Appearance.hpp>
+#include <wrl/Material.hpp>
+#include <wrl/ImageTexture.hpp>
+#include <wrl/IndexedFaceSet.hpp>
+#include <wrl/IndexedLineSet.hpp>
+
+// see Wrlb.hpp for a description of the file format
+
+class WrlbReader;
+
+class LoaderWrlb : public Loader {
+
+private:
+
+  const static char* _ext;
+
+public:
+
+  LoaderWrlb()  {};
+  ~LoaderWrlb() {};
+
+  bool  load(const char* filename, SceneGraph& wrl);
+  const char* ext() const { return _ext; }
+
+private:
+
+  void loadChildren(WrlbReader& rd, Group& group);
+  void loadGroup(WrlbReader& rd, Group& group);
+  void loadTransform(WrlbReader& rd, Transform& transform);
+  void loadShape(WrlbReader& rd, Shape& shape);
+  void loadAppearance(WrlbReader& rd, Appearance& appearance);
+  void loadMaterial(WrlbReader& rd, Material& material);
+  void loadImageTexture(WrlbReader& rd, ImageTexture& imageTexture);
+  void loadIndexedFaceSet(WrlbReader& rd, IndexedFaceSet& ifs);
+  void loadIndexedLineSet(WrlbReader& rd, IndexedLineSet& ils);
+};
+
+#endif /* _LOADER_WRLB_HPP_ */
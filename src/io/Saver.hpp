@@ -36,12 +36,19 @@
 #define _Saver_h_
 
 #include <wrl/SceneGraph.hpp>
+#include "FloatFormat.hpp"
 
 class Saver {
 
 public:
 
+  // as with loaders, save may be called from several threads at once
   virtual bool  save(const char* filename, SceneGraph& wrl) const = 0;
+  // savers which write floating point values as text override this one
+  virtual bool  save(const char* filename, SceneGraph& wrl,
+                     const FloatFormat& /*format*/) const {
+    return save(filename,wrl);
+  }
   virtual const char* ext() const = 0;
 
 };
@@ -0,0 +1,578 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// SaverGlb.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <charconv>
+#include <map>
+#include <unordered_map>
+#include "SaverGlb.hpp"
+#include "StrException.hpp"
+
+const char* SaverGlb::_ext = "glb";
+
+// glTF constants
+#define GLB_MAGIC          0x46546C67 // "glTF"
+#define GLB_VERSION        2
+#define GLB_CHUNK_JSON     0x4E4F534A // "JSON"
+#define GLB_CHUNK_BIN      0x004E4942 // "BIN\0"
+#define GL_ARRAY_BUFFER         34962
+#define GL_ELEMENT_ARRAY_BUFFER 34963
+#define GL_UNSIGNED_SHORT       5123
+#define GL_UNSIGNED_INT         5125
+#define GL_FLOAT                5126
+
+// accumulates the JSON arrays and the binary buffer of the file
+class GlbBuilder {
+public:
+  string         nodes;
+  string         meshes;
+  string         materials;
+  string         textures;
+  string         images;
+  string         accessors;
+  string         bufferViews;
+  vector<char>   bin;
+  int            nNodes;
+  int            nMeshes;
+  int            nMaterials;
+  int            nTextures;
+  int            nAccessors;
+  int            nBufferViews;
+  // shared nodes are saved once; the attributes and indices of each
+  // IndexedFaceSet, a mesh for each IndexedFaceSet and Appearance pair,
+  // and a material for each Appearance and doubleSided pair
+  map<const Node*,string>                    primitive;
+  map<pair<const Node*,const Node*>,int>     mesh;
+  map<pair<const Node*,bool>,int>            material;
+  GlbBuilder():
+    nNodes(0),nMeshes(0),nMaterials(0),
+    nTextures(0),nAccessors(0),nBufferViews(0) {
+  }
+};
+
+static void jsonFloat(string& json, float f) {
+  if(isfinite(f)==false) f = 0.0f;
+  char buf[32];
+  to_chars_result r = to_chars(buf,buf+sizeof(buf),f);
+  json.append(buf,r.ptr);
+}
+
+static void jsonInt(string& json, const long i) {
+  json += to_string(i);
+}
+
+static void jsonString(string& json, const string& str) {
+  json += '"';
+  for(char c : str) {
+    if(c=='"' || c=='\\') {
+      json += '\\'; json += c;
+    } else if((unsigned char)c<0x20) {
+      char buf[8];
+      snprintf(buf,sizeof(buf),"\\u%04x",c);
+      json += buf;
+    } else {
+      json += c;
+    }
+  }
+  json += '"';
+}
+
+static void jsonFloats(string& json, const float* f, const int n) {
+  json += '[';
+  for(int i=0;i<n;i++) {
+    if(i>0) json += ',';
+    jsonFloat(json,f[i]);
+  }
+  json += ']';
+}
+
+// starts a new element of a JSON array
+static void jsonNext(string& array) {
+  if(array.size()>0) array += ',';
+}
+
+// appends the bytes to the binary buffer, aligned to 4 bytes, and adds
+// a buffer view for them
+static int glbBufferView
+(GlbBuilder& glb, const void* data, const size_t size,
+ const int stride, const int target) {
+  while(glb.bin.size()%4!=0) glb.bin.push_back(0);
+  const size_t offset = glb.bin.size();
+  glb.bin.insert(glb.bin.end(),(const char*)data,(const char*)data+size);
+  string& json = glb.bufferViews;
+  jsonNext(json);
+  json += "{\"buffer\":0,\"byteOffset\":"; jsonInt(json,(long)offset);
+  json += ",\"byteLength\":"; jsonInt(json,(long)size);
+  if(stride>0) { json += ",\"byteStride\":"; jsonInt(json,stride); }
+  json += ",\"target\":"; jsonInt(json,target);
+  json += '}';
+  return glb.nBufferViews++;
+}
+
+static int glbAccessor
+(GlbBuilder& glb, const int bufferView, const size_t offset,
+ const int componentType, const size_t count, const char* type,
+ const float* min=(const float*)0, const float* max=(const float*)0) {
+  string& json = glb.accessors;
+  jsonNext(json);
+  json += "{\"bufferView\":"; jsonInt(json,bufferView);
+  json += ",\"byteOffset\":"; jsonInt(json,(long)offset);
+  json += ",\"componentType\":"; jsonInt(json,componentType);
+  json += ",\"count\":"; jsonInt(json,(long)count);
+  json += ",\"type\":\""; json += type; json += '"';
+  if(min!=(const float*)0 && max!=(const float*)0) {
+    json += ",\"min\":"; jsonFloats(json,min,3);
+    json += ",\"max\":"; jsonFloats(json,max,3);
+  }
+  json += '}';
+  return glb.nAccessors++;
+}
+
+// returns the index of the value bound to the corner iC of face iF, or
+// -1 if the field is not bound
+static inline int glbBoundIndex
+(const IndexedFaceSet::Binding binding, const vector<int>& index,
+ const vector<int>& coordIndex, const int iF, const int iC) {
+  switch(binding) {
+  case IndexedFaceSet::PB_PER_VERTEX:       return coordIndex[iC];
+  case IndexedFaceSet::PB_PER_CORNER:       return index[iC];
+  case IndexedFaceSet::PB_PER_FACE:         return iF;
+  case IndexedFaceSet::PB_PER_FACE_INDEXED: return index[iF];
+  default:                                  return -1;
+  }
+}
+
+static void glbCheckIndex(const int i, const size_t n, const char* name) {
+  if(i<0 || (size_t)i>=n)
+    throw new StrException(string("IndexedFaceSet ")+name+" index out of range");
+}
+
+// the key of a vertex of the output stream, made of the indices of its
+// coord, normal, color and texCoord
+class GlbVertex {
+public:
+  int i[4];
+  bool operator==(const GlbVertex& v) const {
+    return i[0]==v.i[0] && i[1]==v.i[1] && i[2]==v.i[2] && i[3]==v.i[3];
+  }
+};
+
+class GlbVertexHash {
+public:
+  size_t operator()(const GlbVertex& v) const {
+    size_t h = 0;
+    for(int k=0;k<4;k++) h = h*0x9E3779B97F4A7C15ull+(uint32_t)v.i[k];
+    return h^(h>>29);
+  }
+};
+
+//////////////////////////////////////////////////////////////////////
+int SaverGlb::saveMaterial
+(GlbBuilder& glb, Appearance* appearance, const bool doubleSided) const {
+  pair<const Node*,bool> key(appearance,doubleSided);
+  map<pair<const Node*,bool>,int>::iterator m = glb.material.find(key);
+  if(m!=glb.material.end()) return m->second;
+  Material*     material = (Material*)0;
+  ImageTexture* texture  = (ImageTexture*)0;
+  if(appearance!=(Appearance*)0) {
+    Node* node = appearance->getMaterial();
+    if(node!=(Node*)0 && node->isMaterial()) material = (Material*)node;
+    node = appearance->getTexture();
+    if(node!=(Node*)0 && node->isImageTexture() &&
+       ((ImageTexture*)node)->getUrl().size()>0)
+      texture = (ImageTexture*)node;
+  }
+  if(texture!=(ImageTexture*)0) {
+    jsonNext(glb.images);
+    glb.images += "{\"uri\":";
+    jsonString(glb.images,texture->getUrl(0));
+    glb.images += '}';
+    jsonNext(glb.textures);
+    glb.textures += "{\"source\":";
+    jsonInt(glb.textures,glb.nTextures);
+    glb.textures += '}';
+  }
+  // as in VRML, the default is an unlit white surface when there is no
+  // Material node
+  float base[4]     = { 1.0f, 1.0f, 1.0f, 1.0f };
+  float emissive[3] = { 0.0f, 0.0f, 0.0f };
+  float roughness   = 1.0f;
+  if(material!=(Material*)0) {
+    Color& d = material->getDiffuseColor();
+    Color& e = material->getEmissiveColor();
+    base[0] = d.r; base[1] = d.g; base[2] = d.b;
+    base[3] = 1.0f-material->getTransparency();
+    emissive[0] = e.r; emissive[1] = e.g; emissive[2] = e.b;
+    roughness = 1.0f-material->getShininess();
+  }
+  string& json = glb.materials;
+  jsonNext(json);
+  json += "{\"pbrMetallicRoughness\":{\"baseColorFactor\":";
+  jsonFloats(json,base,4);
+  if(texture!=(ImageTexture*)0) {
+    json += ",\"baseColorTexture\":{\"index\":";
+    jsonInt(json,glb.nTextures++);
+    json += '}';
+  }
+  json += ",\"metallicFactor\":0,\"roughnessFactor\":";
+  jsonFloat(json,roughness);
+  json += "},\"emissiveFactor\":";
+  jsonFloats(json,emissive,3);
+  if(base[3]<1.0f) json += ",\"alphaMode\":\"BLEND\"";
+  if(doubleSided)  json += ",\"doubleSided\":true";
+  json += '}';
+  glb.material[key] = glb.nMaterials;
+  return glb.nMaterials++;
+}
+
+//////////////////////////////////////////////////////////////////////
+// returns the index of the mesh, or -1 if the Shape has no faces
+int SaverGlb::saveMesh(GlbBuilder& glb, Shape& shape) const {
+  Node* geometry = shape.getGeometry();
+  if(geometry==(Node*)0 || geometry->isIndexedFaceSet()==false) return -1;
+  IndexedFaceSet& ifs = *(IndexedFaceSet*)geometry;
+  Node* appearance = shape.getAppearance();
+  if(appearance!=(Node*)0 && appearance->isAppearance()==false)
+    appearance = (Node*)0;
+
+  pair<const Node*,const Node*> key(geometry,appearance);
+  map<pair<const Node*,const Node*>,int>::iterator m = glb.mesh.find(key);
+  if(m!=glb.mesh.end()) return m->second;
+
+  map<const Node*,string>::iterator p = glb.primitive.find(geometry);
+  if(p==glb.primitive.end())
+    p = glb.primitive.insert(make_pair(geometry,savePrimitive(glb,ifs))).first;
+  if(p->second=="") {
+    glb.mesh[key] = -1;
+    return -1;
+  }
+
+  const int material =
+    saveMaterial(glb,(Appearance*)appearance,ifs.getSolid()==false);
+
+  string& json = glb.meshes;
+  jsonNext(json);
+  json += '{';
+  if(shape.getName()!="") {
+    json += "\"name\":"; jsonString(json,shape.getName()); json += ',';
+  }
+  json += "\"primitives\":[{";
+  json += p->second;
+  json += ",\"material\":"; jsonInt(json,material);
+  json += ",\"mode\":4}]}";
+
+  glb.mesh[key] = glb.nMeshes;
+  return glb.nMeshes++;
+}
+
+//////////////////////////////////////////////////////////////////////
+// saves the vertex attributes and the triangle indices of the
+// IndexedFaceSet, and returns the attributes and indices properties of
+// the primitive, or an empty string if it has no faces
+string SaverGlb::savePrimitive(GlbBuilder& glb, IndexedFaceSet& ifs) const {
+
+  const vector<float>& coord         = ifs.getCoord();
+  const vector<int>&   coordIndex    = ifs.getCoordIndex();
+  const vector<float>& normal        = ifs.getNormal();
+  const vector<int>&   normalIndex   = ifs.getNormalIndex();
+  const vector<float>& color         = ifs.getColor();
+  const vector<int>&   colorIndex    = ifs.getColorIndex();
+  const vector<float>& texCoord      = ifs.getTexCoord();
+  const vector<int>&   texCoordIndex = ifs.getTexCoordIndex();
+  const IndexedFaceSet::Binding nb   = ifs.getNormalBinding();
+  const IndexedFaceSet::Binding cb   = ifs.getColorBinding();
+  const IndexedFaceSet::Binding tb   = ifs.getTexCoordBinding();
+  const bool ccw = ifs.getCcw();
+
+  const size_t nCoord = coord.size()/3;
+  const bool hasNormal   = (nb!=IndexedFaceSet::PB_NONE);
+  const bool hasColor    = (cb!=IndexedFaceSet::PB_NONE);
+  const bool hasTexCoord = (tb!=IndexedFaceSet::PB_NONE);
+
+  // interleaved vertex layout
+  const int normalOffset   = 3;
+  const int colorOffset    = normalOffset+((hasNormal)?3:0);
+  const int texCoordOffset = colorOffset +((hasColor )?3:0);
+  const int stride         = texCoordOffset+((hasTexCoord)?2:0);
+
+  // when all the fields are bound per vertex, the output vertices are
+  // the coords; otherwise a vertex is created for each distinct
+  // combination of coord, normal, color and texCoord indices
+  const bool perVertex =
+    (nb==IndexedFaceSet::PB_NONE || nb==IndexedFaceSet::PB_PER_VERTEX) &&
+    (cb==IndexedFaceSet::PB_NONE || cb==IndexedFaceSet::PB_PER_VERTEX) &&
+    (tb==IndexedFaceSet::PB_NONE || tb==IndexedFaceSet::PB_PER_VERTEX);
+
+  vector<GlbVertex> vertex;
+  unordered_map<GlbVertex,uint32_t,GlbVertexHash> vertexMap;
+  vector<uint32_t> index;
+  vector<uint32_t> polygon;
+  const int nI = (int)coordIndex.size();
+  for(int iF=0,i0=0,i1=0;i1<nI;i0=++i1,iF++) {
+    while(i1<nI && coordIndex[i1]>=0) i1++;
+    polygon.clear();
+    for(int iC=i0;iC<i1;iC++) {
+      GlbVertex v;
+      v.i[0] = coordIndex[iC];
+      v.i[1] = glbBoundIndex(nb,normalIndex,coordIndex,iF,iC);
+      v.i[2] = glbBoundIndex(cb,colorIndex,coordIndex,iF,iC);
+      v.i[3] = glbBoundIndex(tb,texCoordIndex,coordIndex,iF,iC);
+      glbCheckIndex(v.i[0],nCoord,"coord");
+      if(hasNormal)   glbCheckIndex(v.i[1],normal.size()/3,"normal");
+      if(hasColor)    glbCheckIndex(v.i[2],color.size()/3,"color");
+      if(hasTexCoord) glbCheckIndex(v.i[3],texCoord.size()/2,"texCoord");
+      if(perVertex) {
+        polygon.push_back((uint32_t)v.i[0]);
+      } else {
+        pair<unordered_map<GlbVertex,uint32_t,GlbVertexHash>::iterator,bool>
+          r = vertexMap.insert(make_pair(v,(uint32_t)vertex.size()));
+        if(r.second) vertex.push_back(v);
+        polygon.push_back(r.first->second);
+      }
+    }
+    // triangle fan
+    for(size_t k=1;k+1<polygon.size();k++) {
+      index.push_back(polygon[0]);
+      index.push_back(polygon[(ccw)?k:k+1]);
+      index.push_back(polygon[(ccw)?k+1:k]);
+    }
+  }
+  if(index.size()==0) return "";
+
+  if(perVertex) {
+    vertex.resize(nCoord);
+    for(size_t iV=0;iV<nCoord;iV++)
+      vertex[iV].i[0] = vertex[iV].i[1] = vertex[iV].i[2] = vertex[iV].i[3] = (int)iV;
+    // the per vertex fields should have a value for each coord
+    if(hasNormal && normal.size()<coord.size())
+      throw new StrException("IndexedFaceSet normal index out of range");
+    if(hasColor && color.size()<coord.size())
+      throw new StrException("IndexedFaceSet color index out of range");
+    if(hasTexCoord && texCoord.size()/2<nCoord)
+      throw new StrException("IndexedFaceSet texCoord index out of range");
+  }
+
+  // interleaved vertex attributes
+  const size_t nV = vertex.size();
+  vector<float> attr(nV*stride);
+  float min[3] = {  INFINITY,  INFINITY,  INFINITY };
+  float max[3] = { -INFINITY, -INFINITY, -INFINITY };
+  for(size_t iV=0;iV<nV;iV++) {
+    float* a = attr.data()+iV*stride;
+    const GlbVertex& v = vertex[iV];
+    for(int j=0;j<3;j++) {
+      a[j] = coord[3*v.i[0]+j];
+      if(a[j]<min[j]) min[j] = a[j];
+      if(a[j]>max[j]) max[j] = a[j];
+    }
+    if(hasNormal)
+      memcpy(a+normalOffset,&normal[3*v.i[1]],3*sizeof(float));
+    if(hasColor)
+      memcpy(a+colorOffset,&color[3*v.i[2]],3*sizeof(float));
+    if(hasTexCoord) {
+      // glTF texture coordinates start at the top of the image
+      a[texCoordOffset+0] = texCoord[2*v.i[3]+0];
+      a[texCoordOffset+1] = 1.0f-texCoord[2*v.i[3]+1];
+    }
+  }
+  const int vertexView =
+    glbBufferView(glb,attr.data(),attr.size()*sizeof(float),
+                  stride*(int)sizeof(float),GL_ARRAY_BUFFER);
+  const int position =
+    glbAccessor(glb,vertexView,0,GL_FLOAT,nV,"VEC3",min,max);
+  const int normals = (hasNormal)?
+    glbAccessor(glb,vertexView,normalOffset*sizeof(float),GL_FLOAT,nV,"VEC3"):-1;
+  const int colors = (hasColor)?
+    glbAccessor(glb,vertexView,colorOffset*sizeof(float),GL_FLOAT,nV,"VEC3"):-1;
+  const int texCoords = (hasTexCoord)?
+    glbAccessor(glb,vertexView,texCoordOffset*sizeof(float),GL_FLOAT,nV,"VEC2"):-1;
+
+  // 16 bit indices when they fit
+  int indexView;
+  int indexType;
+  if(nV<=65535) {
+    vector<uint16_t> index16(index.begin(),index.end());
+    indexView = glbBufferView(glb,index16.data(),index16.size()*sizeof(uint16_t),
+                              0,GL_ELEMENT_ARRAY_BUFFER);
+    indexType = GL_UNSIGNED_SHORT;
+  } else {
+    indexView = glbBufferView(glb,index.data(),index.size()*sizeof(uint32_t),
+                              0,GL_ELEMENT_ARRAY_BUFFER);
+    indexType = GL_UNSIGNED_INT;
+  }
+  const int indices =
+    glbAccessor(glb,indexView,0,indexType,index.size(),"SCALAR");
+
+  string json = "\"attributes\":{\"POSITION\":"; jsonInt(json,position);
+  if(normals>=0)   { json += ",\"NORMAL\":";     jsonInt(json,normals);   }
+  if(colors>=0)    { json += ",\"COLOR_0\":";    jsonInt(json,colors);    }
+  if(texCoords>=0) { json += ",\"TEXCOORD_0\":"; jsonInt(json,texCoords); }
+  json += "},\"indices\":"; jsonInt(json,indices);
+  return json;
+}
+
+//////////////////////////////////////////////////////////////////////
+// returns the index of the glTF node, or -1 if nothing was saved; the
+// children are saved first, since glTF nodes refer to their children
+// by index, and a node shared by several parents is saved once for
+// each of them, since glTF nodes form a tree
+int SaverGlb::saveNode(GlbBuilder& glb, Node* node) const {
+  if(node==(Node*)0) return -1;
+  int mesh = -1;
+  vector<int> children;
+  if(node->isShape()) {
+    mesh = saveMesh(glb,*(Shape*)node);
+    if(mesh<0) return -1;
+  } else if(node->isGroup()) {
+    Group* group = (Group*)node;
+    for(Node* child : group->getChildren()) {
+      int iChild = saveNode(glb,child);
+      if(iChild>=0) children.push_back(iChild);
+    }
+  } else {
+    return -1;
+  }
+
+  string& json = glb.nodes;
+  jsonNext(json);
+  json += '{';
+  bool first = true;
+  if(node->getName()!="") {
+    json += "\"name\":"; jsonString(json,node->getName());
+    first = false;
+  }
+  if(mesh>=0) {
+    if(first==false) json += ',';
+    json += "\"mesh\":"; jsonInt(json,mesh);
+    first = false;
+  }
+  if(node->isTransform()) {
+    float M[16];
+    ((Transform*)node)->getMatrix(M);
+    // getMatrix returns the matrix by rows, and glTF stores it by columns
+    float Mt[16];
+    for(int i=0;i<4;i++)
+      for(int j=0;j<4;j++)
+        Mt[4*j+i] = M[4*i+j];
+    if(first==false) json += ',';
+    json += "\"matrix\":"; jsonFloats(json,Mt,16);
+    first = false;
+  }
+  if(children.size()>0) {
+    if(first==false) json += ',';
+    json += "\"children\":[";
+    for(size_t i=0;i<children.size();i++) {
+      if(i>0) json += ',';
+      jsonInt(json,children[i]);
+    }
+    json += ']';
+  }
+  json += '}';
+  return glb.nNodes++;
+}
+
+//////////////////////////////////////////////////////////////////////
+bool SaverGlb::save(const char* filename, SceneGraph& wrl) const {
+  bool success = false;
+  if(filename==(char*)0) return success;
+
+  try {
+
+    GlbBuilder glb;
+    vector<int> scene;
+    for(Node* child : wrl.getChildren()) {
+      int iNode = saveNode(glb,child);
+      if(iNode>=0) scene.push_back(iNode);
+    }
+
+    // both chunks are padded to 4 bytes, the JSON chunk with spaces
+    while(glb.bin.size()%4!=0) glb.bin.push_back(0);
+
+    string json = "{\"asset\":{\"version\":\"2.0\",\"generator\":\"SaverGlb\"}";
+    json += ",\"scene\":0,\"scenes\":[{\"nodes\":[";
+    for(size_t i=0;i<scene.size();i++) {
+      if(i>0) json += ',';
+      jsonInt(json,scene[i]);
+    }
+    json += "]}]";
+    if(glb.nNodes>0)       json += ",\"nodes\":["       + glb.nodes       + "]";
+    if(glb.nMeshes>0)      json += ",\"meshes\":["      + glb.meshes      + "]";
+    if(glb.nMaterials>0)   json += ",\"materials\":["   + glb.materials   + "]";
+    if(glb.nTextures>0)    json += ",\"textures\":["    + glb.textures    + "]";
+    if(glb.nTextures>0)    json += ",\"images\":["      + glb.images      + "]";
+    if(glb.nAccessors>0)   json += ",\"accessors\":["   + glb.accessors   + "]";
+    if(glb.nBufferViews>0) json += ",\"bufferViews\":[" + glb.bufferViews + "]";
+    if(glb.bin.size()>0) {
+      json += ",\"buffers\":[{\"byteLength\":";
+      jsonInt(json,(long)glb.bin.size());
+      json += "}]";
+    }
+    json += '}';
+
+    while(json.size()%4!=0) json += ' ';
+
+    const uint64_t length =
+      12+8+json.size()+((glb.bin.size()>0)?8+glb.bin.size():0);
+    if(length>UINT32_MAX) throw new StrException("glb file larger than 4GB");
+
+    // the glTF header and chunk headers are little endian, as the hosts
+    // we build for
+    FILE* fp = fopen(filename,"wb");
+    if(fp==(FILE*)0) throw new StrException("unable to open file");
+    uint32_t header[3] = { GLB_MAGIC, GLB_VERSION, (uint32_t)length };
+    uint32_t jsonHeader[2] = { (uint32_t)json.size(), GLB_CHUNK_JSON };
+    uint32_t binHeader[2]  = { (uint32_t)glb.bin.size(), GLB_CHUNK_BIN };
+    success =
+      fwrite(header,sizeof(header),1,fp)==1 &&
+      fwrite(jsonHeader,sizeof(jsonHeader),1,fp)==1 &&
+      fwrite(json.data(),1,json.size(),fp)==json.size();
+    if(success && glb.bin.size()>0)
+      success =
+        fwrite(binHeader,sizeof(binHeader),1,fp)==1 &&
+        fwrite(glb.bin.data(),1,glb.bin.size(),fp)==glb.bin.size();
+    fclose(fp);
+
+  } catch(StrException* e) {
+
+    fprintf(stderr,"ERROR | %s\n",e->what());
+    delete e;
+    success = false;
+
+  }
+
+  return success;
+}
@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// SaverGlb.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef _SAVER_GLB_HPP_
+#define _SAVER_GLB_HPP_
+
+#include "Saver.hpp"
+#include <wrl/Shape.hpp>
+#include <wrl/Appearance.hpp>
+#include <wrl/Material.hpp>
+#include <wrl/ImageTexture.hpp>
+#include <wrl/IndexedFaceSet.hpp>
+#include <wrl/Transform.hpp>
+
+class GlbBuilder;
+
+// saves the scene graph as a binary glTF 2.0 (.glb) file
+//
+// Group and Transform nodes become glTF nodes, with the Transform
+// matrix, and each Shape with an IndexedFaceSet geometry becomes a
+// mesh with a single triangle primitive; Shapes which share their
+// geometry and appearance share the mesh, and the buffers of a shared
+// IndexedFaceSet are saved once; the polygons are triangulated as
+// fans, and the normal, color and texCoord bindings are resolved into
+// a single indexed vertex stream, with the attributes interleaved in
+// one buffer view; the Material diffuseColor, emissiveColor and
+// transparency, and the ImageTexture url, become a metallic-roughness
+// material; other geometry nodes are not saved
+
+class SaverGlb : public Saver {
+
+private:
+
+  const static char* _ext;
+
+public:
+
+  SaverGlb()  {};
+  ~SaverGlb() {};
+
+  bool  save(const char* filename, SceneGraph& wrl) const;
+  const char* ext() const { return _ext; }
+
+private:
+
+  int    saveNode(GlbBuilder& glb, Node* node) const;
+  int    saveMesh(GlbBuilder& glb, Shape& shape) const;
+  string savePrimitive(GlbBuilder& glb, IndexedFaceSet& ifs) const;
+  int    saveMaterial(GlbBuilder& glb, Appearance* appearance, const bool doubleSided) const;
+
+};
+
+#endif /* _SAVER_GLB_HPP_ */
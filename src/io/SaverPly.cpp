@@ -0,0 +1,213 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// SaverPly.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <stdint.h>
+#include <string.h>
+#include "SaverPly.hpp"
+#include <wrl/SceneGraphTraversal.hpp>
+
+const char* SaverPly::_ext = "ply";
+
+static bool plyHostIsLittleEndian() {
+  const uint16_t one = 1;
+  return *(const uint8_t*)&one==1;
+}
+
+static unsigned char plyColor(const float c) {
+  return (unsigned char)((c<=0.0f)?0:(c>=1.0f)?255:(int)(255.0f*c+0.5f));
+}
+
+//////////////////////////////////////////////////////////////////////
+void SaverPly::saveHeader
+(Writer& w, IndexedFaceSet& ifs, const bool hasNormal,
+ const bool hasColor, const int nFaces, const int maxFaceSize) const {
+  w.write("ply\nformat ");
+  w.write((_binary==false)?"ascii":
+          plyHostIsLittleEndian()?"binary_little_endian":"binary_big_endian");
+  w.write(" 1.0\n");
+  w.write("element vertex "); w.writeInt(ifs.getNumberOfCoord()); w.write('\n');
+  w.write("property float x\nproperty float y\nproperty float z\n");
+  if(hasNormal)
+    w.write("property float nx\nproperty float ny\nproperty float nz\n");
+  if(hasColor)
+    w.write("property uchar red\nproperty uchar green\nproperty uchar blue\n");
+  if(nFaces>0) {
+    w.write("element face "); w.writeInt(nFaces); w.write('\n');
+    w.write((maxFaceSize<256)?
+            "property list uchar int vertex_indices\n":
+            "property list int int vertex_indices\n");
+  }
+  w.write("end_header\n");
+}
+
+//////////////////////////////////////////////////////////////////////
+void SaverPly::saveAscii
+(Writer& w, IndexedFaceSet& ifs, const bool hasNormal,
+ const bool hasColor, const FloatFormat& format) const {
+  const vector<float>& coord  = ifs.getCoord();
+  const vector<float>& normal = ifs.getNormal();
+  const vector<float>& color  = ifs.getColor();
+  const int nV = ifs.getNumberOfCoord();
+  for(int iV=0;iV<nV;iV++) {
+    for(int j=0;j<3;j++) {
+      if(j>0) w.write(' ');
+      w.writeFloat(coord[3*iV+j],format);
+    }
+    if(hasNormal)
+      for(int j=0;j<3;j++) {
+        w.write(' '); w.writeFloat(normal[3*iV+j],format);
+      }
+    if(hasColor)
+      for(int j=0;j<3;j++) {
+        w.write(' '); w.writeInt(plyColor(color[3*iV+j]));
+      }
+    w.write('\n');
+  }
+  const vector<int>& coordIndex = ifs.getCoordIndex();
+  const int nI = (int)coordIndex.size();
+  for(int i0=0,i1=0;i1<nI;i0=++i1) {
+    while(i1<nI && coordIndex[i1]>=0) i1++;
+    if(i1==i0) continue;
+    w.writeInt(i1-i0);
+    for(int i=i0;i<i1;i++) {
+      w.write(' '); w.writeInt(coordIndex[i]);
+    }
+    w.write('\n');
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+void SaverPly::saveBinary
+(Writer& w, IndexedFaceSet& ifs, const bool hasNormal,
+ const bool hasColor, const int maxFaceSize) const {
+  const vector<float>& coord  = ifs.getCoord();
+  const vector<float>& normal = ifs.getNormal();
+  const vector<float>& color  = ifs.getColor();
+  const int nV = ifs.getNumberOfCoord();
+  if(hasNormal==false && hasColor==false) {
+    // the vertex records are the coord array itself
+    w.write((const char*)coord.data(),3*nV*sizeof(float));
+  } else {
+    char record[27];
+    size_t size = 0;
+    for(int iV=0;iV<nV;iV++) {
+      memcpy(record,&coord[3*iV],3*sizeof(float));
+      size = 3*sizeof(float);
+      if(hasNormal) {
+        memcpy(record+size,&normal[3*iV],3*sizeof(float));
+        size += 3*sizeof(float);
+      }
+      if(hasColor)
+        for(int j=0;j<3;j++)
+          record[size++] = (char)plyColor(color[3*iV+j]);
+      w.write(record,size);
+    }
+  }
+  const vector<int>& coordIndex = ifs.getCoordIndex();
+  const int nI = (int)coordIndex.size();
+  for(int i0=0,i1=0;i1<nI;i0=++i1) {
+    while(i1<nI && coordIndex[i1]>=0) i1++;
+    if(i1==i0) continue;
+    int32_t n = i1-i0;
+    if(maxFaceSize<256)
+      w.write((char)n);
+    else
+      w.write((const char*)&n,sizeof(int32_t));
+    w.write((const char*)&coordIndex[i0],n*sizeof(int32_t));
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+bool SaverPly::save(const char* filename, SceneGraph& wrl) const {
+  return save(filename,wrl,FloatFormat());
+}
+
+//////////////////////////////////////////////////////////////////////
+bool SaverPly::save
+(const char* filename, SceneGraph& wrl, const FloatFormat& format) const {
+  bool success = false;
+  if(filename==(char*)0) return success;
+
+  // find the first Shape node with an IndexedFaceSet geometry
+  IndexedFaceSet* ifs = (IndexedFaceSet*)0;
+  SceneGraphTraversal t(wrl);
+  t.start();
+  Node* node;
+  while(ifs==(IndexedFaceSet*)0 && (node=t.next())!=(Node*)0) {
+    if(node->isShape()) {
+      Node* geometry = ((Shape*)node)->getGeometry();
+      if(geometry!=(Node*)0 && geometry->isIndexedFaceSet())
+        ifs = (IndexedFaceSet*)geometry;
+    }
+  }
+  if(ifs==(IndexedFaceSet*)0) return success;
+
+  const int  nV        = ifs->getNumberOfCoord();
+  const bool hasNormal =
+    ifs->getNormalBinding()==IndexedFaceSet::PB_PER_VERTEX &&
+    (int)ifs->getNormal().size()==3*nV;
+  const bool hasColor  =
+    ifs->getColorBinding()==IndexedFaceSet::PB_PER_VERTEX &&
+    (int)ifs->getColor().size()==3*nV;
+
+  // face indices are written as they are, so they should be valid
+  int nFaces = 0;
+  int maxFaceSize = 0;
+  const vector<int>& coordIndex = ifs->getCoordIndex();
+  const int nI = (int)coordIndex.size();
+  for(int i0=0,i1=0;i1<nI;i0=++i1) {
+    while(i1<nI && coordIndex[i1]>=0) {
+      if(coordIndex[i1]>=nV) return success;
+      i1++;
+    }
+    if(i1>i0) nFaces++;
+    if(i1-i0>maxFaceSize) maxFaceSize = i1-i0;
+  }
+
+  FILE* fp = fopen(filename,(_binary)?"wb":"w");
+  if(fp!=(FILE*)0) {
+    {
+      Writer w(fp);
+      saveHeader(w,*ifs,hasNormal,hasColor,nFaces,maxFaceSize);
+      if(_binary)
+        saveBinary(w,*ifs,hasNormal,hasColor,maxFaceSize);
+      else
+        saveAscii(w,*ifs,hasNormal,hasColor,format.resolve(FloatFormat::shortest()));
+      success = w.flush();
+    }
+    fclose(fp);
+  }
+  return success;
+}
@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// SaverPly.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef _SAVER_PLY_HPP_
+#define _SAVER_PLY_HPP_
+
+#include "Saver.hpp"
+#include "Writer.hpp"
+#include <wrl/Shape.hpp>
+#include <wrl/IndexedFaceSet.hpp>
+
+// saves the first IndexedFaceSet of the scene graph as a PLY file;
+// normals and colors are only saved when they are bound per vertex,
+// and a point cloud is saved as a vertex element without faces;
+// binary files are written in the byte order of the host
+
+class SaverPly : public Saver {
+
+private:
+
+  const static char* _ext;
+
+public:
+
+  SaverPly()  : _binary(true) {};
+  ~SaverPly() {};
+
+  bool  save(const char* filename, SceneGraph& wrl) const;
+  // the format only applies to ascii files
+  bool  save(const char* filename, SceneGraph& wrl, const FloatFormat& format) const;
+  const char* ext() const { return _ext; }
+
+  // if set, save binary instead of ascii PLY files
+  bool  getBinary() const      { return _binary; }
+  void  setBinary(bool value)  { _binary = value; }
+
+private:
+
+  bool _binary;
+
+  void saveHeader(Writer& w, IndexedFaceSet& ifs, const bool hasNormal,
+                  const bool hasColor, const int nFaces,
+                  const int maxFaceSize) const;
+  void saveAscii(Writer& w, IndexedFaceSet& ifs, const bool hasNormal,
+                 const bool hasColor, const FloatFormat& format) const;
+  void saveBinary(Writer& w, IndexedFaceSet& ifs, const bool hasNormal,
+                  const bool hasColor, const int maxFaceSize) const;
+
+};
+
+#endif /* _SAVER_PLY_HPP_ */
@@ -34,6 +34,9 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
 #include "SaverStl.hpp"
 
 #include "wrl/Shape.hpp"
@@ -41,12 +44,149 @@
 #include "wrl/Material.hpp"
 #include "wrl/IndexedFaceSet.hpp"
 
-#include "core/Faces.hpp"
+#include "core/TriangleFaces.hpp"
 
 const char* SaverStl::_ext = "stl";
 
+// binary STL records are written in blocks of this many triangles
+#define STL_BINARY_BLOCK_SIZE 4096
+#define STL_BINARY_RECORD_SIZE 50
+#define STL_BINARY_HEADER_SIZE 84
+
+//////////////////////////////////////////////////////////////////////
+// STL files have one normal per face; it is taken from the normal
+// array according to its binding, or computed from the coordinates
+// when the IndexedFaceSet has no normals
+template <class FacesT>
+void SaverStl::faceNormal(IndexedFaceSet& ifs, const FacesT& faces, int iF, float n[3]) const {
+    vector<float>& normal = ifs.getNormal();
+    vector<int>& normalIndex = ifs.getNormalIndex();
+    int iC = faces.getFaceFirstCorner(iF);
+    int iN = -1;
+    switch (ifs.getNormalBinding()) {
+    case IndexedFaceSet::PB_PER_FACE:
+        iN = iF;
+        break;
+    case IndexedFaceSet::PB_PER_FACE_INDEXED:
+        iN = normalIndex[iF];
+        break;
+    case IndexedFaceSet::PB_PER_VERTEX:
+        // the normal of the first vertex, as written by LoaderStl
+        iN = faces.getFaceVertex(iF, 0);
+        break;
+    case IndexedFaceSet::PB_PER_CORNER:
+        iN = normalIndex[iC];
+        break;
+    default:
+        break;
+    }
+    if (iN >= 0 && 3 * iN + 2 < static_cast<int>(normal.size())) {
+        n[0] = normal[3 * iN];
+        n[1] = normal[3 * iN + 1];
+        n[2] = normal[3 * iN + 2];
+        return;
+    }
+    vector<float>& coord = ifs.getCoord();
+    const float* v0 = &coord[3 * faces.getFaceVertex(iF, 0)];
+    const float* v1 = &coord[3 * faces.getFaceVertex(iF, 1)];
+    const float* v2 = &coord[3 * faces.getFaceVertex(iF, 2)];
+    float e1[3] = { v1[0] - v0[0], v1[1] - v0[1], v1[2] - v0[2] };
+    float e2[3] = { v2[0] - v0[0], v2[1] - v0[1], v2[2] - v0[2] };
+    n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+    n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+    n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+    float nn = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if (nn > 0.0f) {
+        n[0] /= nn; n[1] /= nn; n[2] /= nn;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+static void writeAsciiFacet(Writer& w, const float values[12], const FloatFormat& format) {
+    w.write("facet normal");
+    for (int j = 0; j < 3; ++j) {
+        w.write(' '); w.writeFloat(values[j], format);
+    }
+    w.write("\n  outer loop\n");
+    for (int cornerNumber = 0; cornerNumber < 3; ++cornerNumber) {
+        w.write("    vertex");
+        for (int j = 0; j < 3; ++j) {
+            w.write(' '); w.writeFloat(values[3 + 3 * cornerNumber + j], format);
+        }
+        w.write('\n');
+    }
+    w.write("  endloop\nendfacet\n");
+}
+
+template <class FacesT>
+bool SaverStl::saveAscii(FILE* fp, const char* solidName, IndexedFaceSet& ifs, const FacesT& faces,
+                         const FloatFormat& format) const {
+    vector<float>& coord = ifs.getCoord();
+    float values[12];
+    Writer w(fp);
+    w.write("solid "); w.write(solidName); w.write('\n');
+    int nFaces = faces.getNumberOfFaces();
+    for (int faceNumber = 0; faceNumber < nFaces; ++faceNumber) {
+        faceNormal(ifs, faces, faceNumber, values);
+        for (int cornerNumber = 0; cornerNumber < 3; ++cornerNumber) {
+            int vertexNumber = faces.getFaceVertex(faceNumber, cornerNumber);
+            memcpy(values + 3 + 3 * cornerNumber, &coord[3 * vertexNumber], 3 * sizeof(float));
+        }
+        writeAsciiFacet(w, values, format);
+    }
+    w.write("endsolid "); w.write(solidName); w.write('\n');
+    return w.flush();
+}
+
+//////////////////////////////////////////////////////////////////////
+template <class FacesT>
+bool SaverStl::saveBinary(FILE* fp, const char* solidName, IndexedFaceSet& ifs, const FacesT& faces) const {
+    vector<float>& coord = ifs.getCoord();
+
+    // 80 byte header; it should not start with "solid", since some
+    // readers take that as a sign of an ascii file
+    char header[80];
+    memset(header, 0, sizeof(header));
+    snprintf(header, sizeof(header), "binary STL %s", solidName);
+    uint32_t nFaces = static_cast<uint32_t>(faces.getNumberOfFaces());
+    if (fwrite(header, 1, sizeof(header), fp) != sizeof(header) ||
+        fwrite(&nFaces, sizeof(uint32_t), 1, fp) != 1) {
+        return false;
+    }
+
+    // the records are little endian, as the hosts we build for; the
+    // 16 bit attribute byte count is left as zero
+    vector<char> buffer(STL_BINARY_BLOCK_SIZE * STL_BINARY_RECORD_SIZE, 0);
+    float values[12];
+    uint32_t faceNumber = 0;
+    while (faceNumber < nFaces) {
+        uint32_t nBlock = nFaces - faceNumber;
+        if (nBlock > STL_BINARY_BLOCK_SIZE) nBlock = STL_BINARY_BLOCK_SIZE;
+        char* record = buffer.data();
+        for (uint32_t i = 0; i < nBlock; ++i, ++faceNumber) {
+            faceNormal(ifs, faces, static_cast<int>(faceNumber), values);
+            for (int cornerNumber = 0; cornerNumber < 3; ++cornerNumber) {
+                int vertexNumber = faces.getFaceVertex(static_cast<int>(faceNumber), cornerNumber);
+                memcpy(values + 3 + 3 * cornerNumber, &coord[3 * vertexNumber], 3 * sizeof(float));
+            }
+            memcpy(record, values, sizeof(values));
+            record += STL_BINARY_RECORD_SIZE;
+        }
+        size_t nBytes = static_cast<size_t>(nBlock) * STL_BINARY_RECORD_SIZE;
+        if (fwrite(buffer.data(), 1, nBytes, fp) != nBytes) {
+            return false;
+        }
+    }
+    return true;
+}
+
 //////////////////////////////////////////////////////////////////////
 bool SaverStl::save(const char* filename, SceneGraph& wrl) const {
+  return save(filename, wrl, FloatFormat());
+}
+
+//////////////////////////////////////////////////////////////////////
+bool SaverStl::save(const char* filename, SceneGraph& wrl, const FloatFormat& format) const {
   bool success = false;
   if(filename!=(char*)0) {
 
@@ -70,25 +210,26 @@ bool SaverStl::save(const char* filename, SceneGraph& wrl) const {
     IndexedFaceSet* geometry = nullptr;
     for (auto child : children) {
         if (child->isShape()) {
-            geometry = (IndexedFaceSet*) ((Shape*) child)->getGeometry();
+            Node* node = ((Shape*) child)->getGeometry();
+            if (node != nullptr && node->isIndexedFaceSet()) {
+                geometry = (IndexedFaceSet*) node;
+            }
         }
     }
     if (!geometry) {
         return false; //TODO add exception
     }
     vector<int>& coordIndex = geometry->getCoordIndex();
-    vector<float>& coord = geometry->getCoord();
-    vector<int>& normalIndex = geometry->getNormalIndex();
-    vector<float>& normal = geometry->getNormal();
-    int numberVertex = geometry->getNumberOfCorners(); //is this okay?
-    if (!geometry->isIndexedFaceSet()) {
-        return false; //not supported yet
+    if (!geometry->isTriangleMesh()) {
+        return false; // STL files only have triangles
     }
 
-    Faces faces = Faces(numberVertex, coordIndex);
-    Vec3f vec3fBuffer;
+    // the faces only borrow coordIndex, which outlives them; since
+    // STL files only have triangles, the corners are found without
+    // building the general Faces lookup arrays
+    TriangleFaces faces(geometry->getNumberOfCoord(), coordIndex.data(), static_cast<int>(coordIndex.size()));
 
-    FILE* fp = fopen(filename,"w");
+    FILE* fp = fopen(filename,_binary?"wb":"w");
     if(	fp!=(FILE*)0) {
 
       // if set, use ifs->getName()
@@ -96,37 +237,81 @@ bool SaverStl::save(const char* filename, SceneGraph& wrl) const {
       // but first remove directory and extension
       const string& solidName = wrl.getName();
       const char* solidNameCstr = solidName.empty() ? filename : solidName.c_str();
-      fprintf(fp,"solid %s\n",solidNameCstr);
-      for (int faceNumber = 0;;++faceNumber) {
-            if (faces.getFaceVertex(faceNumber, 0) == -1) {
-                break;
-            }
-            int normalNumber = normalIndex.empty() ? faceNumber : normalIndex[faceNumber];
-            vec3fBuffer.x = normal[3 * normalNumber];
-            vec3fBuffer.y = normal[3 * normalNumber + 1];
-            vec3fBuffer.z = normal[3 * normalNumber + 2];
-            fprintf(fp,"facet normal %f %f %f\n", vec3fBuffer.x, vec3fBuffer.y, vec3fBuffer.z);
-            fprintf(fp, "  outer loop\n");
-            for (int cornerNumber = 0; cornerNumber < 3; ++cornerNumber) {
-                int vertexNumber = faces.getFaceVertex(faceNumber, cornerNumber);
-                vec3fBuffer.x = coord[3 * vertexNumber];
-                vec3fBuffer.y = coord[3 * vertexNumber + 1];
-                vec3fBuffer.z = coord[3 * vertexNumber + 2];
-                fprintf(fp,"    vertex %f %f %f\n", vec3fBuffer.x, vec3fBuffer.y, vec3fBuffer.z);
-            }
-            fprintf(fp, "  endloop\nendfacet\n");
+      if (_binary) {
+        success = saveBinary(fp, solidNameCstr, *geometry, faces);
+      } else {
+        success = saveAscii(fp, solidNameCstr, *geometry, faces,
+                            format.resolve(FloatFormat::fixed(6)));
       }
-      fprintf(fp,"endsolid %s\n",solidNameCstr);
-
-      // TODO ...
-      // for each face {
-      //   ...
-      // }
       
       fclose(fp);
-      success = true;
     }
 
   }
   return success;
 }
+
+//////////////////////////////////////////////////////////////////////
+SaverStlStream::SaverStlStream(const char* filename, bool binary, const FloatFormat& format):
+    _fp(nullptr),
+    _writer(nullptr),
+    _binary(binary),
+    _format(format.resolve(FloatFormat::fixed(6))),
+    _solidName((filename != nullptr) ? filename : ""),
+    _nFacets(0) {
+    if (filename != nullptr) {
+        _fp = fopen(filename, _binary ? "wb" : "w");
+    }
+    if (_fp == nullptr) {
+        return;
+    }
+    _writer = new Writer(_fp);
+    if (_binary) {
+        // the number of facets is written by end()
+        char header[STL_BINARY_HEADER_SIZE];
+        memset(header, 0, sizeof(header));
+        snprintf(header, 80, "binary STL %s", _solidName.c_str());
+        _writer->write(header, sizeof(header));
+    } else {
+        _writer->write("solid "); _writer->write(_solidName); _writer->write('\n');
+    }
+}
+
+SaverStlStream::~SaverStlStream() {
+    delete _writer;
+    if (_fp != nullptr) fclose(_fp);
+}
+
+void SaverStlStream::facet(const float values[12]) {
+    if (_writer == nullptr) return;
+    if (_binary) {
+        static const char attribute[2] = { 0, 0 };
+        _writer->write(reinterpret_cast<const char*>(values), 12 * sizeof(float));
+        _writer->write(attribute, sizeof(attribute));
+    } else {
+        writeAsciiFacet(*_writer, values, _format);
+    }
+    ++_nFacets;
+}
+
+bool SaverStlStream::end() {
+    if (_writer == nullptr) return false;
+    // as in SaverStl::save, empty meshes are saved without facets
+    bool success = (_nFacets <= UINT32_MAX);
+    if (!_binary) {
+        _writer->write("endsolid "); _writer->write(_solidName); _writer->write('\n');
+    }
+    if (!_writer->flush()) success = false;
+    delete _writer;
+    _writer = nullptr;
+    if (_binary) {
+        uint32_t nFacets = static_cast<uint32_t>(_nFacets);
+        if (fseek(_fp, 80, SEEK_SET) != 0 ||
+            fwrite(&nFacets, sizeof(nFacets), 1, _fp) != 1) {
+            success = false;
+        }
+    }
+    if (fclose(_fp) != 0) success = false;
+    _fp = nullptr;
+    return success;
+}
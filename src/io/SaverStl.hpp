@@ -38,6 +38,10 @@
 #define _SAVER_STL_HPP_
 
 #include "Saver.hpp"
+#include "StlSink.hpp"
+#include "Writer.hpp"
+
+#include "wrl/IndexedFaceSet.hpp"
 
 class SaverStl : public Saver {
 
@@ -47,14 +51,60 @@ const static char* _ext;
 
 public:
 
-  SaverStl()  {};
+  SaverStl()  : _binary(false) {};
   ~SaverStl() {};
 
   bool  save(const char* filename, SceneGraph& wrl) const;
+  // the format only applies to ascii files
+  bool  save(const char* filename, SceneGraph& wrl, const FloatFormat& format) const;
   const char* ext() const { return _ext; }
+
+  // if set, save binary instead of ascii STL files
+  bool  getBinary() const      { return _binary; }
+  void  setBinary(bool value)  { _binary = value; }
   
 private:
 
+  bool _binary;
+
+  // FacesT is either Faces or TriangleFaces
+  template <class FacesT>
+  void faceNormal(IndexedFaceSet& ifs, const FacesT& faces, int iF, float n[3]) const;
+  template <class FacesT>
+  bool saveAscii(FILE* fp, const char* solidName, IndexedFaceSet& ifs, const FacesT& faces,
+                 const FloatFormat& format) const;
+  template <class FacesT>
+  bool saveBinary(FILE* fp, const char* solidName, IndexedFaceSet& ifs, const FacesT& faces) const;
+
+};
+
+// writes the facets received from LoaderStl::stream as they arrive,
+// in the same format as SaverStl; the number of facets of binary files
+// is written at the end, so the file has to be seekable
+class SaverStlStream : public StlSink {
+
+public:
+
+    SaverStlStream(const char* filename, bool binary, const FloatFormat& format);
+    ~SaverStlStream();
+
+    SaverStlStream(const SaverStlStream&)            = delete;
+    SaverStlStream& operator=(const SaverStlStream&) = delete;
+
+    bool isOpen() const { return _writer != nullptr; }
+
+    void facet(const float values[12]);
+    bool end();
+
+private:
+
+    FILE*       _fp;
+    Writer*     _writer;
+    bool        _binary;
+    FloatFormat _format;
+    string      _solidName;
+    uint64_t    _nFacets;
+
 };
 
 #endif /* _SAVER_STL_HPP_ */
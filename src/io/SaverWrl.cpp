@@ -32,16 +32,124 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <limits.h>
 #include "SaverWrl.hpp"
+#include "Writer.hpp"
 
 const char* SaverWrl::_ext = "wrl";
 
+//////////////////////////////////////////////////////////////////////
+// the whole file is formatted into the buffer of the single Writer
+// created by save(), rather than with one fprintf call per value, and
+// flushed to the file when the buffer is full; by default each tuple is written on its own
+// line, preceded by the indentation, as in the original format; in
+// compact mode values are separated by single spaces, and lines are
+// only broken after a tuple once they reach SAVER_WRL_LINE_LENGTH
+
+void SaverWrl::saveVecFloat
+(Writer& w, const string& indent, const FloatFormat& format,
+ const vector<float>& vec, const int nPerTuple) const {
+  int i,j,n = (int)vec.size();
+  if(_compact) {
+    bool eol = false;
+    for(i=j=0;i<n;i++) {
+      if(i>0) w.write((eol)?'\n':' ');
+      w.writeFloat(vec[i],format);
+      if(++j==nPerTuple) j = 0;
+      eol = (j==0 && w.getLineLength()>=SAVER_WRL_LINE_LENGTH);
+    }
+    if(n>0) w.write('\n');
+  } else {
+    for(i=0;i<n;i++) {
+      w.write(indent);
+      w.writeFloat(vec[i],format,8);
+      w.write(' ');
+      if(i%nPerTuple==nPerTuple-1) { w.write(indent); w.write('\n'); }
+    }
+  }
+}
+
+void SaverWrl::saveFloats
+(Writer& w, const string& indent, const char* field,
+ initializer_list<float> values, const FloatFormat& format) const {
+  w.write(indent);
+  w.write(' ');
+  w.write(field);
+  for(float value : values) {
+    w.write(' ');
+    w.writeFloat(value,format,8);
+  }
+  w.write('\n');
+}
+
+void SaverWrl::saveVecInt
+(Writer& w, const string& indent, const vector<int>& vec,
+ const int width) const {
+  int i,n = (int)vec.size();
+  if(_compact) {
+    bool eol = false;
+    for(i=0;i<n;i++) {
+      if(i>0) w.write((eol)?'\n':' ');
+      w.writeInt(vec[i]);
+      eol = (vec[i]<0 && w.getLineLength()>=SAVER_WRL_LINE_LENGTH);
+    }
+    if(n>0) w.write('\n');
+  } else {
+    for(i=0;i<n;i++) {
+      w.write(indent);
+      w.writeInt(vec[i],width);
+      w.write(' ');
+      if(vec[i]<0) { w.write(indent); w.write('\n'); }
+    }
+  }
+}
+
+void SaverWrl::saveLine
+(Writer& w, const string& indent, const char* line) const {
+  w.write(indent);
+  w.write(line);
+  w.write('\n');
+}
+
+void SaverWrl::saveDef
+(Writer& w, const string& indent, const Node* node, const char* type) const {
+  w.write(indent);
+  const string& name = node->getName();
+  if(name!="") {
+    w.write("DEF ");
+    w.write(name);
+    w.write(' ');
+  }
+  w.write(type);
+  w.write(" {\n");
+}
+
+//////////////////////////////////////////////////////////////////////
+bool SaverWrl::saveUse
+(Writer& w, const string& indent, const Node* node, DefMap& def) const {
+  // unnamed nodes cannot be instanced, and are written in full
+  const string& name = node->getName();
+  if(name=="") return false;
+  DefMap::iterator i = def.find(name);
+  if(i!=def.end() && i->second==node) {
+    w.write(indent);
+    w.write("USE ");
+    w.write(name);
+    w.write('\n');
+    return true;
+  }
+  // first time this node is written, or the name was DEF'ed again
+  // for another node
+  def[name] = node;
+  return false;
+}
+
 //////////////////////////////////////////////////////////////////////
 void SaverWrl::saveMaterial
-(FILE* fp, string indent, Material* material) const {
+(Writer& w, string indent, Material* material,
+ const FloatFormat& format, DefMap& def) const {
   if(material==(Material*)0) return;
-
-  const char* str = indent.c_str();
+  if(saveUse(w,indent,material,def)) return;
 
   // Material {
   //   SFFloat ambientIntensity 0.2
@@ -52,48 +160,44 @@ void SaverWrl::saveMaterial
   //   SFFloat transparency     0
   // }
 
-  const string& name = material->getName();
-  if(name=="")
-    fprintf(fp,"%sMaterial {\n",str);
-  else
-    fprintf(fp,"%sDEF %s Material {\n",str,name.c_str());
+  saveDef(w,indent,material,"Material");
 
   float  ambientIntensity = material->getAmbientIntensity();
   if(ambientIntensity!=0.2f)
-    fprintf(fp,"%s ambientIntensity %8.4f\n",str,ambientIntensity);
+    saveFloats(w,indent,"ambientIntensity",{ambientIntensity},format);
 
   Color& diffuseColor     = material->getDiffuseColor();
   if(diffuseColor.r!=0.8f||diffuseColor.g!=0.8f||diffuseColor.b!=0.8f)
-    fprintf(fp,"%s diffuseColor %8.4f %8.4f %8.4f\n",str,
-            diffuseColor.r,diffuseColor.g,diffuseColor.b);
+    saveFloats(w,indent,"diffuseColor",
+               {diffuseColor.r,diffuseColor.g,diffuseColor.b},format);
 
   Color& emissiveColor    = material->getEmissiveColor();
   if(emissiveColor.r!=0.0f||emissiveColor.g!=0.0f||emissiveColor.b!=0.0f)
-    fprintf(fp,"%s emissiveColor %8.4f %8.4f %8.4f\n",str,
-            emissiveColor.r,emissiveColor.g,emissiveColor.b);
+    saveFloats(w,indent,"emissiveColor",
+               {emissiveColor.r,emissiveColor.g,emissiveColor.b},format);
 
   float  shininess        = material->getShininess();
   if(shininess!=0.2f)
-    fprintf(fp,"%s shininess %8.4f\n",str,shininess);
+    saveFloats(w,indent,"shininess",{shininess},format);
 
   Color  specularColor    = material->getSpecularColor();
   if(specularColor.r!=0.0f||specularColor.g!=0.0f||specularColor.b!=0.0f)
-    fprintf(fp,"%s specularColor %8.4f %8.4f %8.4f\n",str,
-            specularColor.r,specularColor.g,specularColor.b);
+    saveFloats(w,indent,"specularColor",
+               {specularColor.r,specularColor.g,specularColor.b},format);
 
   float  transparency     = material->getTransparency();
   if(transparency!=0.2f)
-    fprintf(fp,"%s transparency %8.4f\n",str,transparency);
+    saveFloats(w,indent,"transparency",{transparency},format);
 
-  fprintf(fp,"%s}\n",str);
+  saveLine(w,indent,"}");
 }
 
 //////////////////////////////////////////////////////////////////////
 void SaverWrl::saveImageTexture
-(FILE* fp, string indent, ImageTexture* imageTexture) const {
+(Writer& w, string indent, ImageTexture* imageTexture,
+ DefMap& def) const {
   if(imageTexture==(ImageTexture*)0) return;
-
-  const char* str = indent.c_str();
+  if(saveUse(w,indent,imageTexture,def)) return;
 
   // ImageTexture {
   //   MFString url []
@@ -101,39 +205,42 @@ void SaverWrl::saveImageTexture
   //   SFBool repeatT TRUE
   // }
 
-  const string& name = imageTexture->getName();
-  if(name=="")
-    fprintf(fp,"%sImageTexture {\n",str);
-  else
-    fprintf(fp,"%sDEF %s ImageTexture {\n",str,name.c_str());
+  saveDef(w,indent,imageTexture,"ImageTexture");
 
   vector<string>& url = imageTexture->getUrl();
   if(url.size()) {
-    fprintf(fp,"%s url %s\n",str,url[0].c_str());
+    w.write(indent);
+    w.write(" url ");
+    w.write(url[0]);
+    w.write('\n');
   } else if(url.size()>1) {
-    fprintf(fp,"%s url [\n",str);
-    for(int i=0;i<(int)url.size();i++)
-      fprintf(fp,"%s  %s\n",str,url[i].c_str());
-    fprintf(fp,"%s ]\n",str);
+    saveLine(w,indent," url [");
+    for(int i=0;i<(int)url.size();i++) {
+      w.write(indent);
+      w.write("  ");
+      w.write(url[i]);
+      w.write('\n');
+    }
+    saveLine(w,indent," ]");
   }
 
   bool repeatS = imageTexture->getRepeatS();
   if(repeatS!=true)
-    fprintf(fp,"%s repeatS FALSE\n",str);
+    saveLine(w,indent," repeatS FALSE");
 
   bool repeatT = imageTexture->getRepeatT();
   if(repeatT!=true)
-    fprintf(fp,"%s repeatT FALSE\n",str);
+    saveLine(w,indent," repeatT FALSE");
 
-  fprintf(fp,"%s}\n",str);
+  saveLine(w,indent,"}");
 }
 
 //////////////////////////////////////////////////////////////////////
 void SaverWrl::saveAppearance
-(FILE* fp, string indent, Appearance* appearance) const {
+(Writer& w, string indent, Appearance* appearance,
+ const FloatFormat& format, DefMap& def) const {
   if(appearance==(Appearance*)0) return;
-
-  const char* str = indent.c_str();
+  if(saveUse(w,indent,appearance,def)) return;
 
   // Appearance {
   //   SFNode material NULL
@@ -143,36 +250,32 @@ void SaverWrl::saveAppearance
 
   Node* node;
 
-  const string& name = appearance->getName();
-  if(name=="")
-    fprintf(fp,"%sAppearance {\n",str);
-  else
-    fprintf(fp,"%sDEF %s Appearance {\n",str,name.c_str());
+  saveDef(w,indent,appearance,"Appearance");
 
   node = appearance->getMaterial();
   if(node!=(Node*)0) {
     Material* material = (Material*)node;
-    fprintf(fp,"%s material\n",str);
-    saveMaterial(fp,indent+"  ",material);
+    saveLine(w,indent," material");
+    saveMaterial(w,indent+"  ",material,format,def);
   }
   node = appearance->getTexture();
   if(node!=(Node*)0) {
     if(node->isImageTexture()) {
       ImageTexture* imageTexture = (ImageTexture*)node;
-      fprintf(fp,"%s texture\n",str);
-      saveImageTexture(fp,indent+"  ",imageTexture);
+      saveLine(w,indent," texture");
+      saveImageTexture(w,indent+"  ",imageTexture,def);
     }
   }
 
-  fprintf(fp,"%s}\n",str);
+  saveLine(w,indent,"}");
 }
 
 //////////////////////////////////////////////////////////////////////
 void SaverWrl::saveIndexedFaceSet
-(FILE* fp, string indent, IndexedFaceSet* indexedFaceSet) const {
+(Writer& w, string indent, IndexedFaceSet* indexedFaceSet,
+ const FloatFormat& format, DefMap& def) const {
   if(indexedFaceSet==(IndexedFaceSet*)0) return;
-
-  const char* str = indent.c_str();
+  if(saveUse(w,indent,indexedFaceSet,def)) return;
 
   // IndexedFaceSet {
   //   SFNode  color             NULL
@@ -191,11 +294,7 @@ void SaverWrl::saveIndexedFaceSet
   //   MFInt32 texCoordIndex     []        # [-1,)
   // }
 
-  const string& name = indexedFaceSet->getName();
-  if(name=="")
-    fprintf(fp,"%sIndexedFaceSet {\n",str);
-  else
-    fprintf(fp,"%sDEF %s IndexedFaceSet {\n",str,name.c_str());
+  saveDef(w,indent,indexedFaceSet,"IndexedFaceSet");
 
   IndexedFaceSet& ifs = *indexedFaceSet;
 
@@ -216,35 +315,28 @@ void SaverWrl::saveIndexedFaceSet
 
 
   // default ccw TRUE
-  if(ccw   ==false)   fprintf(fp,"%s ccw FALSE\n",str);
+  if(ccw   ==false)   saveLine(w,indent," ccw FALSE");
   // default convex TRUE
-  if(convex==false)   fprintf(fp,"%s convex FALSE\n",str);
+  if(convex==false)   saveLine(w,indent," convex FALSE");
   // default solid TRUE
-  if(solid ==false)   fprintf(fp,"%s solid FALSE\n",str);
+  if(solid ==false)   saveLine(w,indent," solid FALSE");
   // default creaseAngle 0.0
-  if(creaseAngle>0.0) fprintf(fp,"%s creaseAngle %8.4f\n",str,creaseAngle);
+  if(creaseAngle>0.0)
+    saveFloats(w,indent,"creaseAngle",{creaseAngle},format);
 
   if(coordIndex.size()>0) {
-    int i;
-    fprintf(fp,"%s coordIndex [\n",str);
-    for(i=0;i<(int)coordIndex.size();i++) {
-      fprintf(fp,"%s%6d ",str,coordIndex[i]);
-      if(coordIndex[i]<0) fprintf(fp,"%s\n",str);
-    }
-    fprintf(fp,"%s ]\n",str);
+    saveLine(w,indent," coordIndex [");
+    saveVecInt(w,indent,coordIndex,6);
+    saveLine(w,indent," ]");
   }
 
   // COORD_PER_VERTEX
   if(coord.size()>0) {
-    int i;
-    fprintf(fp,"%s coord Coordinate {\n",str);
-    fprintf(fp,"%s  point [\n",str);
-    for(i=0;i<(int)coord.size();i++) {
-      fprintf(fp,"%s%8.4f ",str,coord[i]);
-      if(i%3==2) fprintf(fp,"%s\n",str);
-    }
-    fprintf(fp,"%s  ]\n",str);
-    fprintf(fp,"%s }\n",str);
+    saveLine(w,indent," coord Coordinate {");
+    saveLine(w,indent,"  point [");
+    saveVecFloat(w,indent,format,coord,3);
+    saveLine(w,indent,"  ]");
+    saveLine(w,indent," }");
   }
 
   // if(normal.size()==0)
@@ -265,26 +357,19 @@ void SaverWrl::saveIndexedFaceSet
   //     normal.size()/3==coord.size()/3
 
   if(normal.size()>0) {
-    int i;
-    fprintf(fp,"%s normalPerVertex %s\n",str,
-            (normalPerVertex==true)?"TRUE":"FALSE");
-
-    fprintf(fp,"%s normal Normal {\n",str);
-    fprintf(fp,"%s  vector [\n",str);
-    for(i=0;i<(int)normal.size();i++) {
-      fprintf(fp,"%s%8.4f ",str,normal[i]);
-      if(i%3==2) fprintf(fp,"%s\n",str);
-    }
-    fprintf(fp,"%s  ]\n",str);
-    fprintf(fp,"%s }\n",str);
+    saveLine(w,indent,(normalPerVertex==true)?
+             " normalPerVertex TRUE":" normalPerVertex FALSE");
+
+    saveLine(w,indent," normal Normal {");
+    saveLine(w,indent,"  vector [");
+    saveVecFloat(w,indent,format,normal,3);
+    saveLine(w,indent,"  ]");
+    saveLine(w,indent," }");
 
     if(normalIndex.size()>0) {
-      fprintf(fp,"%s normalIndex [\n",str);
-      for(i=0;i<(int)normalIndex.size();i++) {
-        fprintf(fp,"%s%d ",str,normalIndex[i]);
-        if(normalIndex[i]<0) fprintf(fp,"%s\n",str);
-      }
-      fprintf(fp,"%s ]\n",str);
+      saveLine(w,indent," normalIndex [");
+      saveVecInt(w,indent,normalIndex,0);
+      saveLine(w,indent," ]");
     }
   }
 
@@ -306,26 +391,19 @@ void SaverWrl::saveIndexedFaceSet
   //     color.size()/3==coord.size()/3
 
   if(color.size()>0) {
-    int i;
-    fprintf(fp,"%s colorPerVertex %s\n",str,
-            (colorPerVertex==true)?"TRUE":"FALSE");
-
-    fprintf(fp,"%s color Color {\n",str);
-    fprintf(fp,"%s  color [\n",str);
-    for(i=0;i<(int)color.size();i++) {
-      fprintf(fp,"%s%8.4f ",str,color[i]);
-      if(i%3==2) fprintf(fp,"%s\n",str);
-    }
-    fprintf(fp,"%s  ]\n",str);
-    fprintf(fp,"%s }\n",str);
+    saveLine(w,indent,(colorPerVertex==true)?
+             " colorPerVertex TRUE":" colorPerVertex FALSE");
+
+    saveLine(w,indent," color Color {");
+    saveLine(w,indent,"  color [");
+    saveVecFloat(w,indent,format,color,3);
+    saveLine(w,indent,"  ]");
+    saveLine(w,indent," }");
 
     if(colorIndex.size()>0) {
-      fprintf(fp,"%s colorIndex [\n",str);
-      for(i=0;i<(int)colorIndex.size();i++) {
-        fprintf(fp,"%s%d ",str,colorIndex[i]);
-        if(colorIndex[i]<0) fprintf(fp,"%s\n",str);
-      }
-      fprintf(fp,"%s ]\n",str);
+      saveLine(w,indent," colorIndex [");
+      saveVecInt(w,indent,colorIndex,0);
+      saveLine(w,indent," ]");
     }
   }
 
@@ -339,36 +417,29 @@ void SaverWrl::saveIndexedFaceSet
   //   texCoord.size()/2==coord.size()/3
 
   if(texCoord.size()>0) {
-    int i;
 
-    fprintf(fp,"%s texCoord TextureCoordinate {\n",str);
-    fprintf(fp,"%s  point [\n",str);
-    for(i=0;i<(int)texCoord.size();i++) {
-      fprintf(fp,"%s%8.4f ",str,texCoord[i]);
-      if(i%2==1) fprintf(fp,"%s\n",str);
-    }
-    fprintf(fp,"%s  ]\n",str);
-    fprintf(fp,"%s }\n",str);
+    saveLine(w,indent," texCoord TextureCoordinate {");
+    saveLine(w,indent,"  point [");
+    saveVecFloat(w,indent,format,texCoord,2);
+    saveLine(w,indent,"  ]");
+    saveLine(w,indent," }");
 
     if(texCoordIndex.size()>0) {
-      fprintf(fp,"%s texCoordIndex [\n",str);
-      for(i=0;i<(int)texCoordIndex.size();i++) {
-        fprintf(fp,"%s%d ",str,texCoordIndex[i]);
-        if(texCoordIndex[i]<0) fprintf(fp,"%s\n",str);
-      }
-      fprintf(fp,"%s ]\n",str);
+      saveLine(w,indent," texCoordIndex [");
+      saveVecInt(w,indent,texCoordIndex,0);
+      saveLine(w,indent," ]");
     }
   }
 
-  fprintf(fp,"%s}\n",str); // IndexedFaceSet
+  saveLine(w,indent,"}"); // IndexedFaceSet
 }
 
 //////////////////////////////////////////////////////////////////////
 void SaverWrl::saveIndexedLineSet
-(FILE* fp, string indent, IndexedLineSet* indexedLineSet) const {
+(Writer& w, string indent, IndexedLineSet* indexedLineSet,
+ const FloatFormat& format, DefMap& def) const {
   if(indexedLineSet==(IndexedLineSet*)0) return;
-
-  const char* str = indent.c_str();
+  if(saveUse(w,indent,indexedLineSet,def)) return;
 
   // IndexedLineSet {
   //   SFNode  coord             NULL
@@ -378,11 +449,7 @@ void SaverWrl::saveIndexedLineSet
   //   SFBool  colorPerVertex    TRUE
   // }
 
-  const string& name = indexedLineSet->getName();
-  if(name=="")
-    fprintf(fp,"%sIndexedLineSet {\n",str);
-  else
-    fprintf(fp,"%sDEF %s IndexedLineSet {\n",str,name.c_str());
+  saveDef(w,indent,indexedLineSet,"IndexedLineSet");
 
   IndexedLineSet& ifs = *indexedLineSet;
 
@@ -393,61 +460,46 @@ void SaverWrl::saveIndexedLineSet
   bool&          colorPerVertex  = ifs.getColorPerVertex();
 
   {
-    int i;
-    fprintf(fp,"%s coordIndex [\n",str);
-    for(i=0;i<(int)coordIndex.size();i++) {
-      fprintf(fp,"%s%6d ",str,coordIndex[i]);
-      if(coordIndex[i]<0) fprintf(fp,"%s\n",str);
-    }
-    fprintf(fp,"%s ]\n",str);
+    saveLine(w,indent," coordIndex [");
+    saveVecInt(w,indent,coordIndex,6);
+    saveLine(w,indent," ]");
   }
 
   // COORD_PER_VERTEX
   {
-    int i;
-    fprintf(fp,"%s coord Coordinate {\n",str);
-    fprintf(fp,"%s  point [\n",str);
-    for(i=0;i<(int)coord.size();i++) {
-      fprintf(fp,"%s%8.4f ",str,coord[i]);
-      if(i%3==2) fprintf(fp,"%s\n",str);
-    }
-    fprintf(fp,"%s  ]\n",str);
-    fprintf(fp,"%s }\n",str);
+    saveLine(w,indent," coord Coordinate {");
+    saveLine(w,indent,"  point [");
+    saveVecFloat(w,indent,format,coord,3);
+    saveLine(w,indent,"  ]");
+    saveLine(w,indent," }");
   }
 
   if(color.size()>0) {
-    int i;
-    fprintf(fp,"%s colorPerVertex %s\n",str,
-            (colorPerVertex==true)?"TRUE":"FALSE");
-
-    fprintf(fp,"%s color Color {\n",str);
-    fprintf(fp,"%s  color [\n",str);
-    for(i=0;i<(int)color.size();i++) {
-      fprintf(fp,"%s%8.4f ",str,color[i]);
-      if(i%3==2) fprintf(fp,"%s\n",str);
-    }
-    fprintf(fp,"%s  ]\n",str);
-    fprintf(fp,"%s }\n",str);
+    saveLine(w,indent,(colorPerVertex==true)?
+             " colorPerVertex TRUE":" colorPerVertex FALSE");
+
+    saveLine(w,indent," color Color {");
+    saveLine(w,indent,"  color [");
+    saveVecFloat(w,indent,format,color,3);
+    saveLine(w,indent,"  ]");
+    saveLine(w,indent," }");
 
     if(colorIndex.size()>0) {
-      fprintf(fp,"%s colorIndex [\n",str);
-      for(i=0;i<(int)colorIndex.size();i++) {
-        fprintf(fp,"%s%d ",str,colorIndex[i]);
-        if(colorIndex[i]<0) fprintf(fp,"%s\n",str);
-      }
-      fprintf(fp,"%s ]\n",str);
+      saveLine(w,indent," colorIndex [");
+      saveVecInt(w,indent,colorIndex,0);
+      saveLine(w,indent," ]");
     }
   }
 
-  fprintf(fp,"%s}\n",str); // IndexedLineSet
+  saveLine(w,indent,"}"); // IndexedLineSet
 }
 
 //////////////////////////////////////////////////////////////////////
 void SaverWrl::saveShape
-(FILE* fp, string indent, Shape* shape) const {
+(Writer& w, string indent, Shape* shape,
+ const FloatFormat& format, DefMap& def) const {
   if(shape==(Shape*)0) return;
-
-  const char* str = indent.c_str();
+  if(saveUse(w,indent,shape,def)) return;
 
   // Shape {
   //   SFNode appearance NULL
@@ -456,41 +508,37 @@ void SaverWrl::saveShape
 
   Node* node;
 
-  const string& name = shape->getName();
-  if(name=="")
-    fprintf(fp,"%sShape {\n",str);
-  else
-    fprintf(fp,"%sDEF %s Shape {\n",str,name.c_str());
+  saveDef(w,indent,shape,"Shape");
 
   node = shape->getAppearance();
   if(node!=(Node*)0) {
-    fprintf(fp,"%s appearance\n",str);
+    saveLine(w,indent," appearance");
     Appearance* appearance = (Appearance*)node;
-    saveAppearance(fp,indent+"  ", appearance);
+    saveAppearance(w,indent+"  ", appearance,format,def);
   }
   node = shape->getGeometry();
   if(node!=(Node*)0) {
     if(node->isIndexedFaceSet()) {
-      fprintf(fp,"%s geometry\n",str);
+      saveLine(w,indent," geometry");
       IndexedFaceSet* indexedFaceSet = (IndexedFaceSet*)node;
-      saveIndexedFaceSet(fp,indent+"  ",indexedFaceSet);
+      saveIndexedFaceSet(w,indent+"  ",indexedFaceSet,format,def);
     } else if(node->isIndexedLineSet()) {
-      fprintf(fp,"%s geometry\n",str);
+      saveLine(w,indent," geometry");
       IndexedLineSet* indexedLineSet = (IndexedLineSet*)node;
-      saveIndexedLineSet(fp,indent+"  ",indexedLineSet);
+      saveIndexedLineSet(w,indent+"  ",indexedLineSet,format,def);
     } else {
       // TBD
     }
   }
-  fprintf(fp,"%s}\n",str);
+  saveLine(w,indent,"}");
 }
 
 //////////////////////////////////////////////////////////////////////
 void SaverWrl::saveTransform
-(FILE* fp, string indent, Transform* transform) const {
+(Writer& w, string indent, Transform* transform,
+ const FloatFormat& format, DefMap& def) const {
   if(transform==(Transform*)0) return;
-
-  const char* str = indent.c_str();
+  if(saveUse(w,indent,transform,def)) return;
 
   // Transform {
   //   SFVec3f    center            0 0 0
@@ -503,79 +551,71 @@ void SaverWrl::saveTransform
   //   MFNode     children          []
   // }
 
-  const string& name = transform->getName();
-  if(name=="")
-    fprintf(fp,"%sTransform {\n",str);
-  else
-    fprintf(fp,"%sDEF %s Transform {\n",str,name.c_str());
+  saveDef(w,indent,transform,"Transform");
 
   Vec3f&    center           = transform->getCenter();
   if(center.x!=0.0f || center.y!=0.0f || center.z!= 0.0f)
-    fprintf(fp,"%s center %8.4f %8.4f %8.4f\n",str,
-            center.x,center.y,center.z);
+    saveFloats(w,indent,"center",{center.x,center.y,center.z},format);
 
   Rotation& rotation         = transform->getRotation();
   Vec3f&    axis             = rotation.getAxis();
   float     angle            = rotation.getAngle();
   if(axis.x!=0.0f || axis.y!=0.0f || axis.z!= 1.0f || angle!= 0.0f)
-    fprintf(fp,"%s rotation %8.4f %8.4f %8.4f %8.4f\n",str,
-            axis.x,axis.y,axis.z,angle);
+    saveFloats(w,indent,"rotation",{axis.x,axis.y,axis.z,angle},format);
 
   Vec3f&    scale            = transform->getScale();
   if(scale.x!=1.0f || scale.y!=1.0f || scale.z!= 1.0f)
-    fprintf(fp,"%s scale %8.4f %8.4f %8.4f\n",str,
-            scale.x,scale.y,scale.z);
+    saveFloats(w,indent,"scale",{scale.x,scale.y,scale.z},format);
 
   Rotation& scaleOrientation = transform->getScaleOrientation();
             axis             = scaleOrientation.getAxis();
             angle            = scaleOrientation.getAngle();
   if(axis.x!=0.0f || axis.y!=0.0f || axis.z!= 1.0f || angle!= 0.0f)
-    fprintf(fp,"%s rotation %8.4f %8.4f %8.4f %8.4f\n",str,
-            axis.x,axis.y,axis.z,angle);
+    saveFloats(w,indent,"rotation",{axis.x,axis.y,axis.z,angle},format);
 
   Vec3f&    translation      = transform->getTranslation();
   if(translation.x!=0.0f || translation.y!=0.0f || translation.z!= 0.0f)
-    fprintf(fp,"%s translation %8.4f %8.4f %8.4f\n",str,
-            translation.x,translation.y,translation.z);
+    saveFloats(w,indent,"translation",
+               {translation.x,translation.y,translation.z},format);
 
   Vec3f&    bboxCenter       = transform->getBBoxCenter();
   if(bboxCenter.x!=0.0f || bboxCenter.y!=0.0f || bboxCenter.z!= 0.0f)
-    fprintf(fp,"%s bboxCenter %8.4f %8.4f %8.4f\n",str,
-            bboxCenter.x,bboxCenter.y,bboxCenter.z);
+    saveFloats(w,indent,"bboxCenter",
+               {bboxCenter.x,bboxCenter.y,bboxCenter.z},format);
   
   Vec3f&    bboxSize         = transform->getBBoxSize();
   if(bboxSize.x!=-1.0f || bboxSize.y!=-1.0f || bboxSize.z!= -1.0f)
-    fprintf(fp,"%s bboxSize %8.4f %8.4f %8.4f\n",str,
-            bboxSize.x,bboxSize.y,bboxSize.z);
+    saveFloats(w,indent,"bboxSize",
+               {bboxSize.x,bboxSize.y,bboxSize.z},format);
   
   int nChildren = transform->getNumberOfChildren();
   if(nChildren>0) {
     Node* node;
-    fprintf(fp,"%s children [\n",indent.c_str());
+    saveLine(w,indent," children [");
     for(int i=0;i<nChildren;i++) {
       node = (*transform)[i];
       if(node->isShape()) {
-        saveShape(fp,indent+"  ",(Shape*)node);
+        saveShape(w,indent+"  ",(Shape*)node,format,def);
 	  } else if(node->isTransform()) {
-        saveTransform(fp,indent+"  ",(Transform*)node);
+        saveTransform(w,indent+"  ",(Transform*)node,format,def);
 	  } else if(node->isGroup()) {
-        saveGroup(fp,indent+"  ",(Group*)node);
+        saveGroup(w,indent+"  ",(Group*)node,format,def);
       } else {
         // throw StrException("unexpected node type as child of Transform");
       }
     }
-    fprintf(fp,"%s ]\n",indent.c_str());
+    saveLine(w,indent," ]");
   }
 
-  fprintf(fp,"%s}\n",str);
+  saveLine(w,indent,"}");
 }
 
 //////////////////////////////////////////////////////////////////////
 void SaverWrl::saveGroup
-(FILE* fp, string indent, Group* group) const {
+(Writer& w, string indent, Group* group,
+ const FloatFormat& format, DefMap& def) const {
   if(group==(Group*)0) return;
-
-  const char* str = indent.c_str();
+  if(saveUse(w,indent,group,def)) return;
 
   // Group {
   //   SFVec3f bboxCenter  0 0 0
@@ -583,21 +623,17 @@ void SaverWrl::saveGroup
   //   MFNode children    []
   // }
 
-  const string& name = group->getName();
-  if(name=="")
-    fprintf(fp,"%sGroup {\n",str);
-  else
-    fprintf(fp,"%sDEF %s Group {\n",str,name.c_str());
+  saveDef(w,indent,group,"Group");
 
   Vec3f&    bboxCenter       = group->getBBoxCenter();
   if(bboxCenter.x!=0.0f || bboxCenter.y!=0.0f || bboxCenter.z!= 0.0f)
-    fprintf(fp,"%s bboxCenter %8.4f %8.4f %8.4f\n",str,
-            bboxCenter.x,bboxCenter.y,bboxCenter.z);
+    saveFloats(w,indent,"bboxCenter",
+               {bboxCenter.x,bboxCenter.y,bboxCenter.z},format);
   
   Vec3f&    bboxSize         = group->getBBoxSize();
   if(bboxSize.x!=-1.0f || bboxSize.y!=-1.0f || bboxSize.z!= -1.0f)
-    fprintf(fp,"%s bboxSize %8.4f %8.4f %8.4f\n",str,
-            bboxSize.x,bboxSize.y,bboxSize.z);
+    saveFloats(w,indent,"bboxSize",
+               {bboxSize.x,bboxSize.y,bboxSize.z},format);
   
   int nChildren = group->getNumberOfChildren();
   if(nChildren>0) {
@@ -605,45 +641,188 @@ void SaverWrl::saveGroup
     for(int i=0;i<nChildren;i++) {
       node = (*group)[i];
       if(node->isShape()) {
-        saveShape(fp,indent+" ",(Shape*)node);
+        saveShape(w,indent+" ",(Shape*)node,format,def);
 	  } else if(node->isTransform()) {
-        saveTransform(fp,indent+" ",(Transform*)node);
+        saveTransform(w,indent+" ",(Transform*)node,format,def);
 	  } else if(node->isGroup()) {
-        saveGroup(fp,indent+" ",(Group*)node);
+        saveGroup(w,indent+" ",(Group*)node,format,def);
       } else {
         // throw StrException("unexpected node type as child of Transform");
       }
     }
   }
 
-  fprintf(fp,"%s}\n",str);
+  saveLine(w,indent,"}");
 }
 
 //////////////////////////////////////////////////////////////////////
 bool SaverWrl::save(const char* filename, SceneGraph& wrl) const {
+  return save(filename,wrl,FloatFormat());
+}
+
+//////////////////////////////////////////////////////////////////////
+bool SaverWrl::save
+(const char* filename, SceneGraph& wrl, const FloatFormat& fmt) const {
+  const FloatFormat format = fmt.resolve(FloatFormat::fixed(4));
   bool success = false;
   if(filename!=(char*)0) {
      FILE* fp = fopen(filename,"w");
     if(	fp!=(FILE*)0) {
-      fprintf(fp,"#VRML V2.0 utf8\n");
-      string indent="";
-      int nChildren = wrl.getNumberOfChildren();
-      for(int i=0;i<nChildren;i++) {
-        Node* node = wrl[i];
-        if(node->isShape()) {
-          Shape* shape = (Shape*)node;
-          saveShape(fp,indent,shape);
-        } else if(node->isTransform()) {
-          Transform* transform = (Transform*)node;
-          saveTransform(fp,indent,transform);
-        } else if(node->isGroup()) {
-          Group* group = (Group*)node;
-          saveGroup(fp,indent,group);
+      {
+        // a single Writer for the whole file, flushed before fclose
+        Writer w(fp);
+        w.write("#VRML V2.0 utf8\n");
+        string indent="";
+        DefMap def;
+        int nChildren = wrl.getNumberOfChildren();
+        for(int i=0;i<nChildren;i++) {
+          Node* node = wrl[i];
+          if(node->isShape()) {
+            Shape* shape = (Shape*)node;
+            saveShape(w,indent,shape,format,def);
+          } else if(node->isTransform()) {
+            Transform* transform = (Transform*)node;
+            saveTransform(w,indent,transform,format,def);
+          } else if(node->isGroup()) {
+            Group* group = (Group*)node;
+            saveGroup(w,indent,group,format,def);
+          }
         }
+        success = w.flush();
       }
-      fclose(fp);
-      success = true;
+      if(fclose(fp)!=0) success = false;
     }
   }
   return success;
 }
+
+//////////////////////////////////////////////////////////////////////
+// facets are spilled and read back in blocks of this many facets
+#define SAVER_WRL_STREAM_BLOCK_SIZE 4096
+
+SaverWrlStream::SaverWrlStream
+(const SaverWrl& saver, const char* filename, const FloatFormat& format):
+  _saver(saver),
+  _format(format.resolve(FloatFormat::fixed(4))),
+  _fp((FILE*)0),
+  _spill((FILE*)0),
+  _nFacets(0),
+  _success(true) {
+  if(filename!=(char*)0) {
+    _fp    = fopen(filename,"w");
+    _spill = tmpfile();
+  }
+  _buffer.reserve(12*SAVER_WRL_STREAM_BLOCK_SIZE);
+}
+
+SaverWrlStream::~SaverWrlStream() {
+  if(_fp!=(FILE*)0)    fclose(_fp);
+  if(_spill!=(FILE*)0) fclose(_spill);
+}
+
+bool SaverWrlStream::spill() {
+  if(_buffer.size()>0) {
+    if(fwrite(_buffer.data(),sizeof(float),_buffer.size(),_spill)!=
+       _buffer.size())
+      _success = false;
+    _buffer.clear();
+  }
+  return _success;
+}
+
+void SaverWrlStream::facet(const float values[12]) {
+  if(isOpen()==false) return;
+  _buffer.insert(_buffer.end(),values,values+12);
+  if(_buffer.size()>=12*SAVER_WRL_STREAM_BLOCK_SIZE) spill();
+  _nFacets++;
+}
+
+bool SaverWrlStream::end() {
+  if(isOpen()==false || spill()==false) return false;
+  // coordIndex values have to fit in an int
+  if(3*_nFacets>(uint64_t)INT_MAX) return false;
+
+  // same output as saveShape() and saveIndexedFaceSet() for the
+  // Shape created by LoaderStl
+
+  Appearance appearance;
+  appearance.setMaterial(new Material());
+  SaverWrl::DefMap def;
+  Writer           w(_fp);
+
+  w.write("#VRML V2.0 utf8\n");
+  w.write("Shape {\n");
+  w.write(" appearance\n");
+  _saver.saveAppearance(w,"  ",&appearance,_format,def);
+  w.write(" geometry\n");
+  w.write("  IndexedFaceSet {\n");
+
+  const string  indent = "  ";
+  const int     nBlock = SAVER_WRL_STREAM_BLOCK_SIZE;
+  vector<int>   index;
+  vector<float> block(12*nBlock);
+  vector<float> vec;
+  uint64_t      iF,nF;
+  int           i,j;
+
+  // as in saveIndexedFaceSet(), empty fields are not written
+  if(_nFacets>0) {
+
+    w.write("   coordIndex [\n");
+    for(iF=0;iF<_nFacets;iF+=nF) {
+      nF = (_nFacets-iF<(uint64_t)nBlock)?_nFacets-iF:(uint64_t)nBlock;
+      index.clear();
+      for(i=0;i<(int)nF;i++) {
+        int i0 = (int)(3*(iF+i));
+        index.push_back(i0);
+        index.push_back(i0+1);
+        index.push_back(i0+2);
+        index.push_back(-1);
+      }
+      _saver.saveVecInt(w,indent,index,6);
+    }
+    w.write("   ]\n");
+
+    // first pass over the spill file : vertices
+    w.write("   coord Coordinate {\n");
+    w.write("    point [\n");
+    rewind(_spill);
+    for(iF=0;iF<_nFacets;iF+=nF) {
+      nF = (_nFacets-iF<(uint64_t)nBlock)?_nFacets-iF:(uint64_t)nBlock;
+      if(fread(block.data(),12*sizeof(float),nF,_spill)!=nF) return false;
+      vec.clear();
+      for(i=0;i<(int)nF;i++)
+        vec.insert(vec.end(),&block[12*i+3],&block[12*i+12]);
+      _saver.saveVecFloat(w,indent,_format,vec,3);
+    }
+    w.write("    ]\n");
+    w.write("   }\n");
+
+    // second pass : one normal per vertex, as in LoaderStl
+    w.write("   normalPerVertex TRUE\n");
+    w.write("   normal Normal {\n");
+    w.write("    vector [\n");
+    rewind(_spill);
+    for(iF=0;iF<_nFacets;iF+=nF) {
+      nF = (_nFacets-iF<(uint64_t)nBlock)?_nFacets-iF:(uint64_t)nBlock;
+      if(fread(block.data(),12*sizeof(float),nF,_spill)!=nF) return false;
+      vec.clear();
+      for(i=0;i<(int)nF;i++)
+        for(j=0;j<3;j++)
+          vec.insert(vec.end(),&block[12*i],&block[12*i+3]);
+      _saver.saveVecFloat(w,indent,_format,vec,3);
+    }
+    w.write("    ]\n");
+    w.write("   }\n");
+
+  }
+
+  w.write("  }\n"); // IndexedFaceSet
+  w.write("}\n");   // Shape
+
+  // nothing is left in the Writer when it goes out of scope
+  if(w.flush()==false) _success = false;
+  if(fclose(_fp)!=0) _success = false;
+  _fp = (FILE*)0;
+  return _success;
+}
@@ -35,7 +35,11 @@
 #ifndef _SAVER_WRL_HPP_
 #define _SAVER_WRL_HPP_
 
+#include <initializer_list>
+#include <map>
 #include "Saver.hpp"
+#include "StlSink.hpp"
+#include "Writer.hpp"
 #include <wrl/Shape.hpp>
 #include <wrl/Appearance.hpp>
 #include <wrl/Material.hpp>
@@ -45,6 +49,9 @@
 #include <wrl/Transform.hpp>
 #include <wrl/SceneGraphTraversal.hpp>
 
+// in compact mode, array lines are broken after this many characters
+#define SAVER_WRL_LINE_LENGTH 1024
+
 class SaverWrl : public Saver {
 
 private:
@@ -53,31 +60,107 @@ const static char* _ext;
 
 public:
 
-  SaverWrl()  {};
+  SaverWrl():_compact(false) {};
   ~SaverWrl() {};
 
   bool  save(const char* filename, SceneGraph& wrl) const;
+  bool  save(const char* filename, SceneGraph& wrl,
+             const FloatFormat& format) const;
   const char* ext() const { return _ext; }
+
+  // compact mode writes arrays on a few long lines, without indentation
+  bool  getCompact() const  { return _compact; }
+  void  setCompact(bool value) { _compact = value; }
   
 private:
+
+  friend class SaverWrlStream;
+
+  bool _compact;
+
+  // named nodes written so far; a node found again under the same
+  // name is written as USE, so that shared nodes stay shared
+  typedef map<string,const Node*> DefMap;
+
+  bool saveUse
+  (Writer& w, const string& indent, const Node* node, DefMap& def) const;
+
+  // the indentation followed by a line of text
+  void saveLine
+  (Writer& w, const string& indent, const char* line) const;
+  // the opening of a node, preceded by DEF and its name if it has one
+  void saveDef
+  (Writer& w, const string& indent, const Node* node, const char* type) const;
+
+  void saveFloats
+  (Writer& w, const string& indent, const char* field,
+   initializer_list<float> values, const FloatFormat& format) const;
+  void saveVecFloat
+  (Writer& w, const string& indent, const FloatFormat& format,
+   const vector<float>& vec, const int nPerTuple) const;
+  void saveVecInt
+  (Writer& w, const string& indent, const vector<int>& vec,
+   const int width) const;
   
   void saveAppearance
-  (FILE* fp, string indent, Appearance* appearance) const;
+  (Writer& w, string indent, Appearance* appearance,
+   const FloatFormat& format, DefMap& def) const;
   void saveGroup
-  (FILE* fp, string indent, Group* group) const;
+  (Writer& w, string indent, Group* group,
+   const FloatFormat& format, DefMap& def) const;
   void saveImageTexture
-  (FILE* fp, string indent, ImageTexture* imageTexture) const;
+  (Writer& w, string indent, ImageTexture* imageTexture,
+   DefMap& def) const;
   void saveIndexedFaceSet
-  (FILE* fp, string indent, IndexedFaceSet* indexedFaceSet) const;
+  (Writer& w, string indent, IndexedFaceSet* indexedFaceSet,
+   const FloatFormat& format, DefMap& def) const;
   void saveIndexedLineSet
-  (FILE* fp, string indent, IndexedLineSet* indexedLineSet) const;
+  (Writer& w, string indent, IndexedLineSet* indexedLineSet,
+   const FloatFormat& format, DefMap& def) const;
   void saveMaterial
-  (FILE* fp, string indent, Material* material) const;
+  (Writer& w, string indent, Material* material,
+   const FloatFormat& format, DefMap& def) const;
   void saveShape
-  (FILE* fp, string indent, Shape* shape) const;
+  (Writer& w, string indent, Shape* shape,
+   const FloatFormat& format, DefMap& def) const;
   void saveTransform
-  (FILE* fp, string indent, Transform* transform) const;
+  (Writer& w, string indent, Transform* transform,
+   const FloatFormat& format, DefMap& def) const;
   
 };
 
+// writes the facets received from LoaderStl::stream as a single
+// Shape, with the same output that LoaderStl followed by SaverWrl
+// would produce; since the coord array has to be written before the
+// normal array, the facets are spilled to a temporary file, which is
+// read twice when the stream ends
+class SaverWrlStream : public StlSink {
+
+public:
+
+  SaverWrlStream
+  (const SaverWrl& saver, const char* filename, const FloatFormat& format);
+  ~SaverWrlStream();
+
+  SaverWrlStream(const SaverWrlStream&)            = delete;
+  SaverWrlStream& operator=(const SaverWrlStream&) = delete;
+
+  bool isOpen() const { return _fp!=(FILE*)0 && _spill!=(FILE*)0; }
+
+  void facet(const float values[12]);
+  bool end();
+
+private:
+
+  const SaverWrl& _saver;
+  FloatFormat     _format;
+  FILE*           _fp;
+  FILE*           _spill;
+  vector<float>   _buffer;
+  uint64_t        _nFacets;
+  bool            _success;
+
+  bool spill();
+};
+
 #endif /* _SAVER_WRL_HPP_ */
@@ -0,0 +1,255 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// SaverWrlb.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "SaverWrlb.hpp"
+#include "Wrlb.hpp"
+
+const char* SaverWrlb::_ext = "wrlb";
+
+//////////////////////////////////////////////////////////////////////
+void SaverWrlb::saveUInt(Writer& w, const uint32_t value) const {
+  w.write((const char*)&value,sizeof(value));
+}
+
+void SaverWrlb::saveFloats(Writer& w, initializer_list<float> values) const {
+  for(float value : values)
+    w.write((const char*)&value,sizeof(value));
+}
+
+void SaverWrlb::savePadding(Writer& w, const size_t alignment) const {
+  static const char zero[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  size_t nPad = (alignment-w.getPosition()%alignment)%alignment;
+  w.write(zero,nPad);
+}
+
+void SaverWrlb::saveString(Writer& w, const string& str) const {
+  saveUInt(w,(uint32_t)str.size());
+  w.write(str);
+  savePadding(w,4);
+}
+
+void SaverWrlb::saveVecFloat(Writer& w, const vector<float>& vec) const {
+  savePadding(w,8);
+  uint64_t n = vec.size();
+  w.write((const char*)&n,sizeof(n));
+  w.write((const char*)vec.data(),vec.size()*sizeof(float));
+}
+
+void SaverWrlb::saveVecInt(Writer& w, const vector<int>& vec) const {
+  savePadding(w,8);
+  uint64_t n = vec.size();
+  w.write((const char*)&n,sizeof(n));
+  w.write((const char*)vec.data(),vec.size()*sizeof(int));
+}
+
+//////////////////////////////////////////////////////////////////////
+void SaverWrlb::saveChildren(Writer& w, Group& group, NodeMap& written) const {
+  // only nodes allowed as children are saved
+  vector<pNode>& children = group.getChildren();
+  uint32_t nChildren = 0;
+  for(Node* child : children)
+    if(child->isShape() || child->isGroup()) nChildren++;
+  saveUInt(w,nChildren);
+  for(Node* child : children)
+    if(child->isShape() || child->isGroup()) saveNode(w,child,written);
+}
+
+//////////////////////////////////////////////////////////////////////
+void SaverWrlb::saveNode(Writer& w, Node* node, NodeMap& written) const {
+
+  if(node==(Node*)0) {
+    saveUInt(w,WRLB_NULL);
+    return;
+  }
+
+  // only the first instance of a shared node is written in full
+  NodeMap::const_iterator i = written.find(node);
+  if(i!=written.end()) {
+    saveUInt(w,WRLB_USE);
+    saveUInt(w,i->second);
+    return;
+  }
+  bool known =
+    node->isGroup() || node->isShape() || node->isAppearance() ||
+    node->isMaterial() || node->isImageTexture() ||
+    node->isIndexedFaceSet() || node->isIndexedLineSet();
+  if(known) {
+    uint32_t index = static_cast<uint32_t>(written.size());
+    written[node] = index;
+  }
+
+  if(node->isTransform()) {
+
+    Transform& t = *((Transform*)node);
+    saveUInt(w,WRLB_TRANSFORM);
+    saveString(w,t.getName());
+    Vec3f& c  = t.getCenter();
+    Vec3f& r  = t.getRotation().getAxis();
+    float  ra = t.getRotation().getAngle();
+    Vec3f& s  = t.getScale();
+    Vec3f& o  = t.getScaleOrientation().getAxis();
+    float  oa = t.getScaleOrientation().getAngle();
+    Vec3f& tr = t.getTranslation();
+    Vec3f& bc = t.getBBoxCenter();
+    Vec3f& bs = t.getBBoxSize();
+    saveFloats(w,{c.x,c.y,c.z, r.x,r.y,r.z,ra, s.x,s.y,s.z,
+                  o.x,o.y,o.z,oa, tr.x,tr.y,tr.z,
+                  bc.x,bc.y,bc.z, bs.x,bs.y,bs.z});
+    saveChildren(w,t,written);
+
+  } else if(node->isGroup()) {
+
+    Group& g = *((Group*)node);
+    saveUInt(w,WRLB_GROUP);
+    saveString(w,g.getName());
+    Vec3f& bc = g.getBBoxCenter();
+    Vec3f& bs = g.getBBoxSize();
+    saveFloats(w,{bc.x,bc.y,bc.z, bs.x,bs.y,bs.z});
+    saveChildren(w,g,written);
+
+  } else if(node->isShape()) {
+
+    Shape& shape = *((Shape*)node);
+    saveUInt(w,WRLB_SHAPE);
+    saveString(w,shape.getName());
+    Node* appearance = shape.getAppearance();
+    if(appearance!=(Node*)0 && appearance->isAppearance()==false)
+      appearance = (Node*)0;
+    saveNode(w,appearance,written);
+    Node* geometry = shape.getGeometry();
+    if(geometry!=(Node*)0 &&
+       geometry->isIndexedFaceSet()==false &&
+       geometry->isIndexedLineSet()==false)
+      geometry = (Node*)0;
+    saveNode(w,geometry,written);
+
+  } else if(node->isAppearance()) {
+
+    Appearance& a = *((Appearance*)node);
+    saveUInt(w,WRLB_APPEARANCE);
+    saveString(w,a.getName());
+    Node* material = a.getMaterial();
+    if(material!=(Node*)0 && material->isMaterial()==false)
+      material = (Node*)0;
+    saveNode(w,material,written);
+    Node* texture = a.getTexture();
+    if(texture!=(Node*)0 && texture->isImageTexture()==false)
+      texture = (Node*)0;
+    saveNode(w,texture,written);
+
+  } else if(node->isMaterial()) {
+
+    Material& m = *((Material*)node);
+    saveUInt(w,WRLB_MATERIAL);
+    saveString(w,m.getName());
+    Color& d = m.getDiffuseColor();
+    Color& e = m.getEmissiveColor();
+    Color  s = m.getSpecularColor();
+    saveFloats(w,{m.getAmbientIntensity(), d.r,d.g,d.b, e.r,e.g,e.b,
+                  m.getShininess(), s.r,s.g,s.b, m.getTransparency()});
+
+  } else if(node->isImageTexture()) {
+
+    ImageTexture& it = *((ImageTexture*)node);
+    saveUInt(w,WRLB_IMAGE_TEXTURE);
+    saveString(w,it.getName());
+    saveUInt(w,(it.getRepeatS())?1:0);
+    saveUInt(w,(it.getRepeatT())?1:0);
+    vector<string>& url = it.getUrl();
+    saveUInt(w,(uint32_t)url.size());
+    for(string& str : url)
+      saveString(w,str);
+
+  } else if(node->isIndexedFaceSet()) {
+
+    IndexedFaceSet& ifs = *((IndexedFaceSet*)node);
+    saveUInt(w,WRLB_INDEXED_FACE_SET);
+    saveString(w,ifs.getName());
+    uint32_t flags = 0;
+    if(ifs.getCcw())             flags |= WRLB_CCW;
+    if(ifs.getConvex())          flags |= WRLB_CONVEX;
+    if(ifs.getSolid())           flags |= WRLB_SOLID;
+    if(ifs.getNormalPerVertex()) flags |= WRLB_NORMAL_PER_VERTEX;
+    if(ifs.getColorPerVertex())  flags |= WRLB_COLOR_PER_VERTEX;
+    saveUInt(w,flags);
+    saveFloats(w,{ifs.getCreaseangle()});
+    saveVecFloat(w,ifs.getCoord());
+    saveVecInt(w,ifs.getCoordIndex());
+    saveVecFloat(w,ifs.getNormal());
+    saveVecInt(w,ifs.getNormalIndex());
+    saveVecFloat(w,ifs.getColor());
+    saveVecInt(w,ifs.getColorIndex());
+    saveVecFloat(w,ifs.getTexCoord());
+    saveVecInt(w,ifs.getTexCoordIndex());
+
+  } else if(node->isIndexedLineSet()) {
+
+    IndexedLineSet& ils = *((IndexedLineSet*)node);
+    saveUInt(w,WRLB_INDEXED_LINE_SET);
+    saveString(w,ils.getName());
+    saveUInt(w,(ils.getColorPerVertex())?1:0);
+    saveVecFloat(w,ils.getCoord());
+    saveVecInt(w,ils.getCoordIndex());
+    saveVecFloat(w,ils.getColor());
+    saveVecInt(w,ils.getColorIndex());
+
+  } else {
+
+    saveUInt(w,WRLB_NULL);
+
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+bool SaverWrlb::save(const char* filename, SceneGraph& wrl) const {
+  bool success = false;
+  if(filename!=(char*)0) {
+    FILE* fp = fopen(filename,"wb");
+    if(fp!=(FILE*)0) {
+      {
+        Writer w(fp);
+        w.write(WRLB_MAGIC,4);
+        saveUInt(w,WRLB_VERSION);
+        saveUInt(w,WRLB_BYTE_ORDER);
+        saveString(w,wrl.getName());
+        NodeMap written;
+        saveChildren(w,wrl,written);
+        success = w.flush();
+      }
+      if(fclose(fp)!=0) success = false;
+    }
+  }
+  return success;
+}
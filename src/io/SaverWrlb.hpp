@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// SaverWrlb.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef _SAVER_WRLB_HPP_
+#define _SAVER_WRLB_HPP_
+
+#include <stdint.h>
+#include <map>
+#include "Saver.hpp"
+#include "Writer.hpp"
+#include <wrl/Shape.hpp>
+#include <wrl/Appearance.hpp>
+#include <wrl/Material.hpp>
+#include <wrl/IndexedFaceSet.hpp>
+#include <wrl/IndexedLineSet.hpp>
+#include <wrl/ImageTexture.hpp>
+#include <wrl/Transform.hpp>
+
+// see Wrlb.hpp for a description of the file format
+
+class SaverWrlb : public Saver {
+
+private:
+
+  const static char* _ext;
+
+public:
+
+  SaverWrlb()  {};
+  ~SaverWrlb() {};
+
+  bool  save(const char* filename, SceneGraph& wrl) const;
+  const char* ext() const { return _ext; }
+
+private:
+
+  // the number of each node already written
+  typedef map<const Node*,uint32_t> NodeMap;
+
+  void saveNode(Writer& w, Node* node, NodeMap& written) const;
+  void saveChildren(Writer& w, Group& group, NodeMap& written) const;
+  void saveUInt(Writer& w, const uint32_t value) const;
+  void saveFloats(Writer& w, initializer_list<float> values) const;
+  void saveString(Writer& w, const string& str) const;
+  void savePadding(Writer& w, const size_t alignment) const;
+  void saveVecFloat(Writer& w, const vector<float>& vec) const;
+  void saveVecInt(Writer& w, const vector<int>& vec) const;
+};
+
+#endif /* _SAVER_WRLB_HPP_ */
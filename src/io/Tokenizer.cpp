@@ -40,59 +40,128 @@
 // DAMAGE.
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <charconv>
 #include "Tokenizer.hpp"
 #include "StrException.hpp"
 
-Tokenizer::Tokenizer(): _skip(true) {
+static inline bool isBlank(const char c) {
+  return (c==' ' || c=='\t' || c=='\n' || c==',' || c=='\015'); // c=="^M"
+}
+
+Tokenizer::Tokenizer():
+  _skip(true),
+  _pos((const char*)0),
+  _end((const char*)0) {
 }
 
 void Tokenizer::setSkipComments(const bool value) {
   _skip = value;
 }
 
+// finds the next token, and returns a pointer to its first character
+// and its length; the pointer points into the current window unless
+// the token straddles two windows, in which case it is copied to
+// _carry; the blank space character which terminates the token is
+// not consumed; it returns false at the end of input
+bool Tokenizer::next(const char*& tkn, size_t& len) {
+  // skip blank space
+  for(;;) {
+    while(_pos<_end && isBlank(*_pos)) _pos++;
+    if(_pos<_end) break;
+    if(fill()==false) { tkn = _pos; len = 0; return false; }
+  }
+  // collect token characters
+  const char* p = _pos;
+  while(p<_end && !isBlank(*p)) p++;
+  if(p<_end) {
+    tkn = _pos; len = static_cast<size_t>(p-_pos); _pos = p;
+    return true;
+  }
+  // reached the end of the window
+  _carry.assign(_pos,p);
+  _pos = p;
+  while(fill()) {
+    p = _pos;
+    while(p<_end && !isBlank(*p)) p++;
+    _carry.append(_pos,p);
+    _pos = p;
+    if(p<_end) break;
+  }
+  tkn = _carry.data(); len = _carry.size();
+  return true;
+}
+
 bool Tokenizer::get() {
-  char c='\0';
+  const char* tkn;
+  size_t      len;
   do {
-    clear();
-    // skip blank space
-    while((c=getc())!=EOF)
-      if(!(c==' ' || c=='\t' || c=='\n' || c==',' || c=='\015'))
-        { push_back(c); break; }
-    // collect token characters
-    while(((c=getc())!=EOF) &&
-          !(c==' ' || c=='\t' || c=='\n' || c==',' || c=='\015')) // c=="^M"
-      push_back(c);
+    if(next(tkn,len))
+      assign(tkn,len);
+    else
+      clear();
     // if comment, get the rest of the line, including blank spaces
-    if(size()>0 && (*this)[0]=='#') {
-      // last blank space character read is not in tkn yet
-      if(c!='\n')
-        push_back(c);
-      while((c=getc())!=EOF && c!='\n')
-        push_back(c);
-    }
-    // terminate the string
-    // push_back('\0');
+    if(size()>0 && (*this)[0]=='#')
+      appendLine();
   } while(_skip && length()>0 && *(begin())=='#');
   
   return (length()>0)?true:false;
 }
 
+bool Tokenizer::getView(string_view& tkn) {
+  const char* p;
+  size_t      len;
+  while(next(p,len)) {
+    if(*p!='#') {
+      tkn = string_view(p,len);
+      return true;
+    }
+    if(_skip) {
+      // skip comment
+      nextline();
+    } else {
+      // comments are returned with the rest of the line, as in get()
+      assign(p,len);
+      appendLine();
+      tkn = string_view(*this);
+      return true;
+    }
+  }
+  clear();
+  tkn = string_view();
+  return false;
+}
+
 void Tokenizer::get(const string& errMsg) /* throw(StrException *) */ {
   if(get()==false) throw new StrException(errMsg);
 }
 
+// appends the characters up to the end of the current line, and
+// consumes the end of line character
+void Tokenizer::appendLine() {
+  for(;;) {
+    const char* p = _pos;
+    while(p<_end && *p!='\n') p++;
+    append(_pos,p);
+    _pos = p;
+    if(p<_end) { _pos++; break; }
+    if(fill()==false) break;
+  }
+}
+
 bool Tokenizer::getline() {
   clear();
-  char c='\0';
-  while((c=getc())!=EOF && c!='\n') {
-    push_back(c);
-  }
+  appendLine();
   return (length()>0)?true:false;
 }
 
 void Tokenizer::nextline() {
-  char c='\0';
-  while((c=getc())!=EOF && c!='\n');
+  for(;;) {
+    while(_pos<_end && *_pos!='\n') _pos++;
+    if(_pos<_end) { _pos++; break; }
+    if(fill()==false) break;
+  }
 }
 
 bool Tokenizer::getBool(bool& b) {
@@ -111,53 +180,114 @@ bool Tokenizer::getBool(bool& b) {
   return success;
 }
 
+// VRML numbers //////////////////////////////////////////////////////
+
+// the following methods parse the characters [b,e) without going
+// through the C locale, and succeed only if all of them are consumed
+
+bool Tokenizer::parseInt(const char* b, const char* e, int& i) {
+  bool negative = false;
+  if(b<e && (*b=='+' || *b=='-')) negative = (*(b++)=='-');
+  int base = 10;
+  if(e-b>2 && b[0]=='0' && (b[1]=='x' || b[1]=='X')) { b += 2; base = 16; }
+  // from_chars would accept a second sign, which sscanf does not
+  if(b<e && (*b=='+' || *b=='-')) return false;
+  // VRML SFInt32 values may be written in hexadecimal, as in C
+  long long value;
+  from_chars_result r = from_chars(b,e,value,base);
+  if(r.ec!=errc() || r.ptr!=e || b==e) return false;
+  if(negative) value = -value;
+  if(value<INT_MIN || value>static_cast<long long>(UINT_MAX)) return false;
+  i = static_cast<int>(value);
+  return true;
+}
+
+bool Tokenizer::parseUInt(const char* b, const char* e, unsigned int& ui) {
+  if(b<e && *b=='+') b++;
+  if(b<e && (*b=='+' || *b=='-')) return false;
+  from_chars_result r = from_chars(b,e,ui);
+  return (r.ec==errc() && r.ptr==e && b<e);
+}
+
+bool Tokenizer::parseFloat(const char* b, const char* e, float& f) {
+  if(b<e && *b=='+') {
+    b++;
+    if(b<e && (*b=='+' || *b=='-')) return false;
+  }
+  from_chars_result r = from_chars(b,e,f);
+  if(r.ptr!=e || b==e) return false;
+  if(r.ec==errc::result_out_of_range) {
+    // let strtof produce the same zero or infinity sscanf used to
+    string str(b,e);
+    f = strtof(str.c_str(),(char**)0);
+  } else if(r.ec!=errc()) {
+    return false;
+  }
+  return true;
+}
+
+// the numeric getters parse the next token in place; the token is
+// only copied into this string when it is not a number, so that the
+// caller can check what was found instead
+
+bool Tokenizer::nextNumber(const char*& tkn, size_t& len) {
+  while(next(tkn,len)) {
+    if(*tkn!='#') return true;
+    if(_skip==false) return true;
+    // skip comment
+    nextline();
+  }
+  return false;
+}
+
+void Tokenizer::notNumber(const char* tkn, const size_t len) {
+  assign(tkn,len);
+  if(len>0 && *tkn=='#')
+    appendLine();
+}
+
 bool Tokenizer::getInt(int& i) {
-  bool success =
-    (get() && (sscanf(&((*this)[0]),"%d",&i)==1));
+  const char* tkn; size_t len;
+  bool success = nextNumber(tkn,len) && parseInt(tkn,tkn+len,i);
+  if(success==false) notNumber(tkn,len);
   return success;
 }
 
 bool Tokenizer::getUInt(unsigned int& ui) {
-  bool success =
-    (get() && (sscanf(&((*this)[0]),"%u",&ui)==1));
+  const char* tkn; size_t len;
+  bool success = nextNumber(tkn,len) && parseUInt(tkn,tkn+len,ui);
+  if(success==false) notNumber(tkn,len);
   return success;
 }
 
 bool Tokenizer::getFloat(float& f) {
-  bool success =
-    (get() && (sscanf(&((*this)[0]),"%f",&f)==1));
+  const char* tkn; size_t len;
+  bool success = nextNumber(tkn,len) && parseFloat(tkn,tkn+len,f);
+  if(success==false) notNumber(tkn,len);
   return success;
 }
 
 bool Tokenizer::getColor(Color& c) {
   bool success =
-    (get() && (sscanf(&((*this)[0]),"%f",&(c.r))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(c.g))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(c.b))==1));
+    getFloat(c.r) && getFloat(c.g) && getFloat(c.b);
   return success;
 }
 
 bool Tokenizer::getVec4f(Vec4f& v) {
   bool success =
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.x))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.y))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.z))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.w))==1));
+    getFloat(v.x) && getFloat(v.y) && getFloat(v.z) && getFloat(v.w);
   return success;
 }
 
 bool Tokenizer::getVec3f(Vec3f& v) {
   bool success =
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.x))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.y))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.z))==1));
+    getFloat(v.x) && getFloat(v.y) && getFloat(v.z);
   return success;
 }
 
 bool Tokenizer::getVec2f(Vec2f& v) {
   bool success =
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.x))==1)) &&
-    (get() && (sscanf(&((*this)[0]),"%f",&(v.y))==1));
+    getFloat(v.x) && getFloat(v.y);
   return success;
 }
 
@@ -166,9 +296,15 @@ bool Tokenizer::equals(const char* str) {
 }
 
 bool Tokenizer::expecting(const string& str) {
-  return get() && this->equals(str.c_str());
+  return expecting(str.c_str());
 }
 
+// the token is only copied into this string when it is not the
+// expected one, so that the caller can check what was found instead
 bool Tokenizer::expecting(const char* str) {
-  return get() && this->equals(str);
+  string_view tkn;
+  if(getView(tkn)==false) return false;
+  if(tkn==str) return true;
+  assign(tkn.data(),tkn.size());
+  return false;
 }
@@ -42,24 +42,49 @@
 #ifndef TOKENIZER_HPP
 #define TOKENIZER_HPP
 
+#include <string_view>
 #include <wrl/Node.hpp>
 
 // abstract class
-// use TokenizerFile or TokenizerString instead
+// use TokenizerFile, TokenizerString, TokenizerMmap,
+// TokenizerReadAhead or TokenizerGzip instead
+//
+// the characters not yet consumed are exposed to the Tokenizer as a
+// window [_pos,_end) of contiguous memory; subclasses point the
+// window at their data, and refill it from fill() when it runs out,
+// so that tokens are scanned without a function call per character
 class Tokenizer : public string {
 
 private:
 
-  bool _skip;
+  bool   _skip;
+  string _carry; // token straddling two consecutive windows
+
+protected:
+
+  const char* _pos;
+  const char* _end;
 
-  virtual char getc() = 0;
+  // called when _pos==_end; should point [_pos,_end) to the next
+  // block of input characters, and return false at the end of input
+  virtual bool fill() = 0;
+
+  bool next(const char*& tkn, size_t& len);
+  bool nextNumber(const char*& tkn, size_t& len);
+  void notNumber(const char* tkn, const size_t len);
+  void appendLine();
 
 public:
 
   Tokenizer();
+  virtual ~Tokenizer() {}
 
   bool get();
   void get(const string& errMsg);
+  // like get(), but the token is not copied into this string; the
+  // view points into the input, and is only valid until the next call
+  // to any method of this class
+  bool getView(string_view& tkn);
   bool getline();
   void nextline();
   bool getBool(bool& b);
@@ -75,6 +100,10 @@ public:
   bool expecting(const char* str);
   void setSkipComments(const bool value);
 
+  static bool parseInt(const char* b, const char* e, int& i);
+  static bool parseUInt(const char* b, const char* e, unsigned int& ui);
+  static bool parseFloat(const char* b, const char* e, float& f);
+
 };
 
 #endif // TOKENIZER_HPP
@@ -42,13 +42,20 @@
 #include <stdio.h>
 #include "TokenizerFile.hpp"
 
+#define TOKENIZER_FILE_BUFFER_SIZE (1<<16)
+
 TokenizerFile::TokenizerFile(FILE* fp):
   Tokenizer(),
-  _fp(fp) {
+  _fp(fp),
+  _buffer(TOKENIZER_FILE_BUFFER_SIZE) {
 }
 
-char TokenizerFile::getc() {
-  return static_cast<char>(std::getc(_fp)); // c library function
+bool TokenizerFile::fill() {
+  // read the next block of characters
+  size_t n = fread(_buffer.data(),1,_buffer.size(),_fp);
+  _pos = _buffer.data();
+  _end = _pos+n;
+  return (n>0);
 }
 
 // #define LINE_BUFFER_LENGTH 1024
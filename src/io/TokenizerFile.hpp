@@ -42,18 +42,20 @@
 #ifndef TOKENIZER_FILE_HPP
 #define TOKENIZER_FILE_HPP
 
+#include <vector>
 #include "Tokenizer.hpp"
 
 class TokenizerFile : public Tokenizer {
 
 protected:
 
-  FILE* _fp;
-  bool  _skip; // if(_skip) skip comments
+  FILE*        _fp;
+  bool         _skip; // if(_skip) skip comments
+  vector<char> _buffer;
 
 private:
 
-  virtual char getc();
+  virtual bool fill();
 
 public:
 
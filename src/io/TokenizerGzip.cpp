@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// TokenizerGzip.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <stdio.h>
+#include <string.h>
+#include <zlib.h>
+#include "TokenizerGzip.hpp"
+#include "StrException.hpp"
+
+// size of the zlib buffer of compressed data
+#define TOKENIZER_GZIP_INPUT_SIZE  (1<<18)
+
+TokenizerGzip::TokenizerGzip(const char* filename):
+  TokenizerReadAhead(),
+  _gz((void*)0) {
+  if(filename==(const char*)0) return;
+  gzFile gz = gzopen(filename,"rb");
+  if(gz==(gzFile)0) return;
+  gzbuffer(gz,TOKENIZER_GZIP_INPUT_SIZE);
+  _gz = (void*)gz;
+  start([gz](char* buffer, size_t size)->long {
+      int n = gzread(gz,buffer,(unsigned)size);
+      if(n<0) {
+        int err;
+        throw new StrException(string("gzip | ")+gzerror(gz,&err));
+      }
+      return (long)n;
+    });
+}
+
+TokenizerGzip::~TokenizerGzip() {
+  // the reader thread must not outlive the gzFile
+  stop();
+  if(_gz!=(void*)0) gzclose((gzFile)_gz);
+}
+
+bool TokenizerGzip::isOpen() const {
+  return (_gz!=(void*)0);
+}
+
+bool TokenizerGzip::isGzip(const char* filename) {
+  bool value = false;
+  if(filename==(const char*)0) return value;
+  FILE* fp = fopen(filename,"rb");
+  if(fp!=(FILE*)0) {
+    unsigned char magic[2];
+    value = (fread(magic,1,2,fp)==2 && magic[0]==0x1f && magic[1]==0x8b);
+    fclose(fp);
+  }
+  return value;
+}
+
+bool TokenizerGzip::getInflatedSize(const char* filename, uint32_t& size) {
+  size = 0;
+  if(filename==(const char*)0) return false;
+  FILE* fp = fopen(filename,"rb");
+  if(fp==(FILE*)0) return false;
+  // ISIZE is the last field of the trailer, in little endian order
+  unsigned char isize[4];
+  bool success = (fseek(fp,-4,SEEK_END)==0 && fread(isize,1,4,fp)==4);
+  fclose(fp);
+  if(success)
+    size = (uint32_t)isize[0]|((uint32_t)isize[1]<<8)|
+      ((uint32_t)isize[2]<<16)|((uint32_t)isize[3]<<24);
+  return success;
+}
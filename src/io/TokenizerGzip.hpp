@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// TokenizerGzip.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef TOKENIZER_GZIP_HPP
+#define TOKENIZER_GZIP_HPP
+
+#include <stdint.h>
+#include "TokenizerReadAhead.hpp"
+
+// reads gzip compressed files, inflating them in large blocks on the
+// read-ahead thread while the previous blocks are being tokenized, so
+// that the uncompressed text is never stored in full, neither in memory
+// nor on disk; fill() throws a StrException if the compressed data is
+// corrupted
+class TokenizerGzip : public TokenizerReadAhead {
+
+private:
+
+  void*        _gz;
+
+public:
+
+  TokenizerGzip(const char* filename);
+  ~TokenizerGzip();
+
+  TokenizerGzip(const TokenizerGzip&)            = delete;
+  TokenizerGzip& operator=(const TokenizerGzip&) = delete;
+
+  // returns false if the file could not be opened
+  bool        isOpen() const;
+
+  // true if the file starts with the gzip magic number
+  static bool isGzip(const char* filename);
+
+  // size of the inflated data modulo 2^32, as stored in the gzip
+  // trailer, which is only exact for files made of a single gzip
+  // member; returns false if it can not be read
+  static bool getInflatedSize(const char* filename, uint32_t& size);
+
+};
+
+#endif // TOKENIZER_GZIP_HPP
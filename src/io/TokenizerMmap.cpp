@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// TokenizerMmap.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <stdio.h>
+#include "TokenizerMmap.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+TokenizerMmap::TokenizerMmap(const char* filename):
+  Tokenizer(),
+  _data((const char*)0),
+  _size(0),
+#ifdef _WIN32
+  _file((void*)0),
+  _mapping((void*)0) {
+  if(filename==(const char*)0) return;
+  HANDLE file =
+    CreateFileA(filename,GENERIC_READ,FILE_SHARE_READ,NULL,
+                OPEN_EXISTING,FILE_FLAG_SEQUENTIAL_SCAN,NULL);
+  if(file==INVALID_HANDLE_VALUE) return;
+  _file = (void*)file;
+  LARGE_INTEGER size;
+  if(GetFileSizeEx(file,&size)==0) return;
+  if(size.QuadPart==0) {
+    // an empty file cannot be mapped
+    _data = "";
+  } else {
+    HANDLE mapping = CreateFileMappingA(file,NULL,PAGE_READONLY,0,0,NULL);
+    if(mapping==NULL) return;
+    _mapping = (void*)mapping;
+    void* data = MapViewOfFile(mapping,FILE_MAP_READ,0,0,0);
+    if(data==NULL) return;
+    _data = (const char*)data;
+    _size = static_cast<size_t>(size.QuadPart);
+  }
+#else
+  _fd(-1) {
+  if(filename==(const char*)0) return;
+  _fd = open(filename,O_RDONLY);
+  if(_fd<0) return;
+  struct stat st;
+  if(fstat(_fd,&st)!=0 || S_ISREG(st.st_mode)==0) return;
+  if(st.st_size==0) {
+    // an empty file cannot be mapped
+    _data = "";
+  } else {
+    void* data =
+      mmap((void*)0,static_cast<size_t>(st.st_size),PROT_READ,MAP_PRIVATE,_fd,0);
+    if(data==MAP_FAILED) return;
+    _data = (const char*)data;
+    _size = static_cast<size_t>(st.st_size);
+    // the file is scanned once, from beginning to end
+    madvise(data,_size,MADV_SEQUENTIAL);
+  }
+#endif
+  // the whole file is a single window
+  _pos = _data;
+  _end = _data+_size;
+}
+
+TokenizerMmap::~TokenizerMmap() {
+#ifdef _WIN32
+  if(_size>0)
+    UnmapViewOfFile((LPCVOID)_data);
+  if(_mapping!=(void*)0)
+    CloseHandle((HANDLE)_mapping);
+  if(_file!=(void*)0)
+    CloseHandle((HANDLE)_file);
+#else
+  if(_size>0)
+    munmap((void*)_data,_size);
+  if(_fd>=0)
+    close(_fd);
+#endif
+}
+
+bool TokenizerMmap::fill() {
+  return false;
+}
+
+bool TokenizerMmap::isMapped() const {
+  return (_data!=(const char*)0);
+}
+
+const char* TokenizerMmap::getData() const {
+  return _data;
+}
+
+size_t TokenizerMmap::getSize() const {
+  return _size;
+}
@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// TokenizerMmap.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef TOKENIZER_MMAP_HPP
+#define TOKENIZER_MMAP_HPP
+
+#include "Tokenizer.hpp"
+
+// maps the whole file into memory, and scans the tokens directly
+// from the mapping; the whole file is a single window, so that
+// fill() is never needed, and files larger than 2GB can be
+// tokenized in 64 bit builds
+class TokenizerMmap : public Tokenizer {
+
+private:
+
+  const char* _data;
+  size_t      _size;
+#ifdef _WIN32
+  void*       _file;
+  void*       _mapping;
+#else
+  int         _fd;
+#endif
+
+  virtual bool fill();
+
+public:
+
+  TokenizerMmap(const char* filename);
+  ~TokenizerMmap();
+
+  TokenizerMmap(const TokenizerMmap&)            = delete;
+  TokenizerMmap& operator=(const TokenizerMmap&) = delete;
+
+  // returns false if the file could not be opened or mapped
+  bool        isMapped() const;
+
+  // the mapped file contents; these pointers remain valid while the
+  // tokenizer exists
+  const char* getData() const;
+  size_t      getSize() const;
+
+};
+
+#endif // TOKENIZER_MMAP_HPP
@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// TokenizerReadAhead.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "TokenizerReadAhead.hpp"
+#include "StrException.hpp"
+
+// size and number of blocks; one is being tokenized while the
+// others are filled by the reader
+#define TOKENIZER_READ_AHEAD_BLOCK_SIZE (1<<20)
+#define TOKENIZER_READ_AHEAD_BLOCKS     3
+
+TokenizerReadAhead::TokenizerReadAhead():
+  Tokenizer(),
+  _blocks(TOKENIZER_READ_AHEAD_BLOCKS),
+  _nRead(0),
+  _nConsumed(0),
+  _holding(false),
+  _done(true),
+  _stop(false),
+  _error((StrException*)0) {
+  for(Block& block : _blocks) {
+    block.data.resize(TOKENIZER_READ_AHEAD_BLOCK_SIZE);
+    block.size = 0;
+  }
+}
+
+TokenizerReadAhead::TokenizerReadAhead(Reader reader):
+  TokenizerReadAhead() {
+  start(reader);
+}
+
+TokenizerReadAhead::TokenizerReadAhead(FILE* fp):
+  TokenizerReadAhead() {
+  if(fp==(FILE*)0) return;
+  start([fp](char* buffer, size_t size)->long {
+      size_t n = fread(buffer,1,size,fp);
+      return (n==0 && ferror(fp))?-1:(long)n;
+    });
+}
+
+TokenizerReadAhead::~TokenizerReadAhead() {
+  stop();
+  delete _error;
+}
+
+void TokenizerReadAhead::start(Reader reader) {
+  stop();
+  _reader = reader;
+  _done   = false;
+  _stop   = false;
+  _thread = thread(&TokenizerReadAhead::run,this);
+}
+
+void TokenizerReadAhead::stop() {
+  if(_thread.joinable()) {
+    {
+      lock_guard<mutex> lock(_mutex);
+      _stop = true;
+    }
+    _cond.notify_all();
+    _thread.join();
+  }
+}
+
+// background thread
+void TokenizerReadAhead::run() {
+  const size_t nBlocks = _blocks.size();
+  unique_lock<mutex> lock(_mutex);
+  for(;;) {
+    // wait for a free block
+    _cond.wait(lock,[&]{ return _stop || _nRead-_nConsumed<nBlocks; });
+    if(_stop) break;
+    Block& block = _blocks[_nRead%nBlocks];
+    lock.unlock();
+    long n;
+    StrException* error = (StrException*)0;
+    try {
+      n = _reader(block.data.data(),block.data.size());
+      if(n<0) error = new StrException("read error");
+    } catch(StrException* e) {
+      n = -1;
+      error = e;
+    }
+    lock.lock();
+    if(n<=0) {
+      _error = error;
+      break;
+    }
+    block.size = (size_t)n;
+    _nRead++;
+    _cond.notify_all();
+  }
+  _done = true;
+  _cond.notify_all();
+}
+
+bool TokenizerReadAhead::fill() {
+  const size_t nBlocks = _blocks.size();
+  unique_lock<mutex> lock(_mutex);
+  if(_holding) {
+    // the current block has been consumed
+    _nConsumed++;
+    _holding = false;
+    _cond.notify_all();
+  }
+  _cond.wait(lock,[&]{ return _done || _nRead>_nConsumed; });
+  if(_nRead>_nConsumed) {
+    Block& block = _blocks[_nConsumed%nBlocks];
+    _pos = block.data.data();
+    _end = _pos+block.size;
+    _holding = true;
+    return true;
+  }
+  if(_error!=(StrException*)0) {
+    StrException* e = _error;
+    _error = (StrException*)0;
+    throw e;
+  }
+  return false;
+}
@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// TokenizerReadAhead.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef TOKENIZER_READ_AHEAD_HPP
+#define TOKENIZER_READ_AHEAD_HPP
+
+#include <stdio.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "Tokenizer.hpp"
+
+class StrException;
+
+// reads the input in large blocks on a background thread, a few blocks
+// ahead of the block being tokenized, so that reading (or inflating)
+// the next block overlaps with parsing the current one
+//
+// the blocks are produced by a Reader function, which should fill the
+// buffer and return the number of characters read, 0 at the end of the
+// input, or a negative number on error; it may also throw a
+// StrException*, which is thrown again from fill() on the parsing thread
+class TokenizerReadAhead : public Tokenizer {
+
+public:
+
+  typedef function<long(char* buffer, size_t size)> Reader;
+
+  TokenizerReadAhead(FILE* fp);
+  TokenizerReadAhead(Reader reader);
+  ~TokenizerReadAhead();
+
+  TokenizerReadAhead(const TokenizerReadAhead&)            = delete;
+  TokenizerReadAhead& operator=(const TokenizerReadAhead&) = delete;
+
+protected:
+
+  // subclasses which own the input source construct the tokenizer,
+  // open the source, and then start the reader; they should stop it
+  // before closing the source
+  TokenizerReadAhead();
+  void start(Reader reader);
+  void stop();
+
+private:
+
+  struct Block {
+    vector<char> data;
+    size_t       size;
+  };
+
+  vector<Block>           _blocks;
+  size_t                  _nRead;     // blocks filled by the reader
+  size_t                  _nConsumed; // blocks released by fill()
+  bool                    _holding;   // a block is being tokenized
+  bool                    _done;      // the reader has finished
+  bool                    _stop;
+  StrException*           _error;
+  Reader                  _reader;
+  mutex                   _mutex;
+  condition_variable      _cond;
+  thread                  _thread;
+
+  virtual bool fill();
+  void         run();
+
+};
+
+#endif // TOKENIZER_READ_AHEAD_HPP
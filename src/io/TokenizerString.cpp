@@ -44,13 +44,12 @@
 
 TokenizerString::TokenizerString(const string& str):
   Tokenizer(),
-  _str(str), // save a copy of str
-  _pos(0) {
+  _str(str) { // save a copy of str
+  // the whole string is a single window
+  _pos = _str.data();
+  _end = _pos+_str.length();
 }
 
-char TokenizerString::getc() {
-  if(_pos<_str.length())
-    return _str[_pos++];
-  else
-    return EOF;
+bool TokenizerString::fill() {
+  return false;
 }
@@ -49,9 +49,8 @@ class TokenizerString : public Tokenizer {
 private:
 
   const string  _str;
-  size_t        _pos;
 
-  virtual char getc();
+  virtual bool fill();
 
 public:
 
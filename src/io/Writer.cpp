@@ -0,0 +1,183 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// Writer.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <string.h>
+#include <math.h>
+#include <charconv>
+#include "Writer.hpp"
+
+Writer::Writer(FILE* fp, size_t bufferSize):
+  _fp(fp),
+  _buffer(bufferSize),
+  _size(0),
+  _flushed(0),
+  _lineStart(0),
+  _lineFlushed(0),
+  _success(true) {
+}
+
+Writer::~Writer() {
+  flush();
+}
+
+bool Writer::flush() {
+  if(_size>0) {
+    if(fwrite(_buffer.data(),1,_size,_fp)!=_size) _success = false;
+    _flushed += _size;
+    // remember the part of the current line already written
+    _lineFlushed += _size-_lineStart;
+    _lineStart = _size = 0;
+  }
+  return _success;
+}
+
+// returns a pointer to n free characters at the end of the buffer
+char* Writer::reserve(const size_t n) {
+  if(_size+n>_buffer.size()) {
+    flush();
+    if(n>_buffer.size()) _buffer.resize(n);
+  }
+  return _buffer.data()+_size;
+}
+
+void Writer::write(const char c) {
+  *reserve(1) = c;
+  _size++;
+  if(c=='\n') { _lineStart = _size; _lineFlushed = 0; }
+}
+
+void Writer::write(const char* str, size_t n) {
+  // str may be null when n is 0, as for the data() of an empty vector
+  if(n==0) return;
+  if(n>=_buffer.size()/2) {
+    // large blocks go straight to the file
+    flush();
+    if(fwrite(str,1,n,_fp)!=n) _success = false;
+    _flushed += n;
+    _lineFlushed += n;
+  } else {
+    memcpy(reserve(n),str,n);
+    _size += n;
+  }
+  const void* nl = memchr(str,'\n',n);
+  if(nl!=nullptr) {
+    // find the last end of line
+    const char* q = str+n;
+    while(*(--q)!='\n');
+    size_t nAfter = static_cast<size_t>(str+n-q-1);
+    if(nAfter<=_size) {
+      _lineStart = _size-nAfter; _lineFlushed = 0;
+    } else {
+      _lineStart = 0; _lineFlushed = nAfter-_size;
+    }
+  }
+}
+
+void Writer::write(const char* str) {
+  write(str,strlen(str));
+}
+
+void Writer::write(const string& str) {
+  write(str.data(),str.size());
+}
+
+void Writer::pad(const char* str, const size_t n, const int width) {
+  size_t w = (width>0)?static_cast<size_t>(width):0;
+  size_t nPad = (w>n)?w-n:0;
+  char* p = reserve(nPad+n);
+  memset(p,' ',nPad);
+  memcpy(p+nPad,str,n);
+  _size += nPad+n;
+}
+
+void Writer::writeInt(const int i, const int width) {
+  char str[16];
+  to_chars_result r = to_chars(str,str+sizeof(str),i);
+  pad(str,static_cast<size_t>(r.ptr-str),width);
+}
+
+void Writer::writeFloat(const float f, const int precision, const int width) {
+  // with at most FLOAT_FORMAT_MAX_DIGITS digits every float fits in
+  // fixed notation; the fallbacks only guard the buffer
+  const int digits =
+    (precision<0)?0:(precision>FLOAT_FORMAT_MAX_DIGITS)?
+    FLOAT_FORMAT_MAX_DIGITS:precision;
+  char str[64];
+  to_chars_result r =
+    to_chars(str,str+sizeof(str),f,chars_format::fixed,digits);
+  if(r.ec!=errc()) {
+    r = to_chars(str,str+sizeof(str),f,chars_format::scientific,digits);
+  }
+  if(r.ec!=errc()) {
+    r = to_chars(str,str+sizeof(str),f);
+  }
+  pad(str,static_cast<size_t>(r.ptr-str),width);
+}
+
+void Writer::writeFloat
+(const float f, const FloatFormat& format, const int width) {
+  float value = f;
+  switch(format.getPolicy()) {
+  case FloatFormat::QUANTIZED:
+    if(format.getTolerance()>0.0f) {
+      double t = static_cast<double>(format.getTolerance());
+      value = static_cast<float>(nearbyint(static_cast<double>(f)/t)*t);
+      if(value==0.0f) value = 0.0f; // no -0
+    }
+    // fall through
+  case FloatFormat::SHORTEST:
+    {
+      char str[64];
+      to_chars_result r = to_chars(str,str+sizeof(str),value);
+      pad(str,static_cast<size_t>(r.ptr-str),width);
+    }
+    break;
+  default:
+    writeFloat(f,format.getDigits(),width);
+    break;
+  }
+}
+
+size_t Writer::getLineLength() const {
+  return _lineFlushed+(_size-_lineStart);
+}
+
+size_t Writer::getPosition() const {
+  return _flushed+_size;
+}
+
+bool Writer::getSuccess() const {
+  return _success;
+}
@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// Writer.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef _WRITER_HPP_
+#define _WRITER_HPP_
+
+#include <stdio.h>
+#include <vector>
+#include <string>
+#include "FloatFormat.hpp"
+
+using namespace std;
+
+// accumulates formatted output in a large buffer, which is written
+// to the file with a single fwrite when full; numbers are formatted
+// with std::to_chars, without going through printf or the C locale
+//
+// the buffer is flushed when the Writer is destroyed, so fprintf
+// calls on the same file should not overlap with a Writer in scope
+class Writer {
+
+public:
+
+  Writer(FILE* fp, size_t bufferSize=(1<<20));
+  ~Writer();
+
+  Writer(const Writer&)            = delete;
+  Writer& operator=(const Writer&) = delete;
+
+  bool   flush();
+
+  void   write(const char c);
+  void   write(const char* str);
+  void   write(const char* str, size_t n);
+  void   write(const string& str);
+
+  // numbers are right aligned to the given width, as in printf
+  void   writeInt(const int i, const int width=0);
+  void   writeFloat(const float f, const int precision, const int width=0);
+  void   writeFloat(const float f, const FloatFormat& format, const int width=0);
+
+  // number of characters written since the last end of line
+  size_t getLineLength() const;
+
+  // number of characters written since the Writer was constructed
+  size_t getPosition() const;
+
+  // false if any fwrite failed
+  bool   getSuccess() const;
+
+private:
+
+  FILE*        _fp;
+  vector<char> _buffer;
+  size_t       _size;
+  size_t       _flushed;
+  size_t       _lineStart;
+  size_t       _lineFlushed;
+  bool         _success;
+
+  char*  reserve(const size_t n);
+  void   pad(const char* str, const size_t n, const int width);
+};
+
+#endif /* _WRITER_HPP_ */
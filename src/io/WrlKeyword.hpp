@@ -0,0 +1,263 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// WrlKeyword.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef _WRL_KEYWORD_HPP_
+#define _WRL_KEYWORD_HPP_
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+// VRML keywords recognized by LoaderWrl; node and field names are
+// mapped to these ids in one step by wrlKeyword(), so that the node
+// parsers can switch on the id instead of comparing the token against
+// every name they accept
+
+enum WrlKeyword {
+  WRL_UNKNOWN = 0,
+  WRL_EMPTY,
+  WRL_OPEN_BRACE,
+  WRL_CLOSE_BRACE,
+  WRL_OPEN_BRACKET,
+  WRL_CLOSE_BRACKET,
+  WRL_DEF,
+  WRL_USE,
+  WRL_NODE_GROUP,
+  WRL_NODE_TRANSFORM,
+  WRL_NODE_SHAPE,
+  WRL_NODE_APPEARANCE,
+  WRL_NODE_MATERIAL,
+  WRL_NODE_IMAGE_TEXTURE,
+  WRL_NODE_INDEXED_FACE_SET,
+  WRL_NODE_INDEXED_LINE_SET,
+  WRL_NODE_COLOR,
+  WRL_NODE_COORDINATE,
+  WRL_NODE_NORMAL,
+  WRL_NODE_TEXTURE_COORDINATE,
+  WRL_FIELD_CHILDREN,
+  WRL_FIELD_BBOX_CENTER,
+  WRL_FIELD_BBOX_SIZE,
+  WRL_FIELD_CENTER,
+  WRL_FIELD_ROTATION,
+  WRL_FIELD_SCALE,
+  WRL_FIELD_SCALE_ORIENTATION,
+  WRL_FIELD_TRANSLATION,
+  WRL_FIELD_APPEARANCE,
+  WRL_FIELD_GEOMETRY,
+  WRL_FIELD_MATERIAL,
+  WRL_FIELD_TEXTURE,
+  WRL_FIELD_AMBIENT_INTENSITY,
+  WRL_FIELD_DIFFUSE_COLOR,
+  WRL_FIELD_EMISSIVE_COLOR,
+  WRL_FIELD_SHININESS,
+  WRL_FIELD_SPECULAR_COLOR,
+  WRL_FIELD_TRANSPARENCY,
+  WRL_FIELD_URL,
+  WRL_FIELD_REPEAT_S,
+  WRL_FIELD_REPEAT_T,
+  WRL_FIELD_COLOR,
+  WRL_FIELD_COORD,
+  WRL_FIELD_NORMAL,
+  WRL_FIELD_TEX_COORD,
+  WRL_FIELD_CCW,
+  WRL_FIELD_COLOR_INDEX,
+  WRL_FIELD_COLOR_PER_VERTEX,
+  WRL_FIELD_CONVEX,
+  WRL_FIELD_COORD_INDEX,
+  WRL_FIELD_CREASE_ANGLE,
+  WRL_FIELD_NORMAL_INDEX,
+  WRL_FIELD_NORMAL_PER_VERTEX,
+  WRL_FIELD_SOLID,
+  WRL_FIELD_TEX_COORD_INDEX,
+  WRL_FIELD_POINT,
+  WRL_FIELD_VECTOR
+};
+
+// FNV-1a hash, evaluated at compile time for the case labels below;
+// two keywords with the same hash would be reported by the compiler
+// as duplicate case values
+constexpr uint32_t wrlKeywordHash(const char* s, size_t n) {
+  uint32_t h = 2166136261u;
+  for(size_t i=0;i<n;i++)
+    h = (h^(uint8_t)s[i])*16777619u;
+  return h;
+}
+
+template<size_t N>
+constexpr uint32_t wrlKeywordHash(const char (&s)[N]) {
+  return wrlKeywordHash(s,N-1);
+}
+
+template<size_t N>
+inline WrlKeyword wrlKeywordMatch
+(const char* s, size_t n, const char (&keyword)[N], WrlKeyword id) {
+  return (n==N-1 && memcmp(s,keyword,n)==0)?id:WRL_UNKNOWN;
+}
+
+inline WrlKeyword wrlKeyword(const char* s, size_t n) {
+  switch(n) {
+  case 0:
+    return WRL_EMPTY;
+  case 1:
+    switch(s[0]) {
+    case '{': return WRL_OPEN_BRACE;
+    case '}': return WRL_CLOSE_BRACE;
+    case '[': return WRL_OPEN_BRACKET;
+    case ']': return WRL_CLOSE_BRACKET;
+    default:  return WRL_UNKNOWN;
+    }
+  default:
+    break;
+  }
+  switch(wrlKeywordHash(s,n)) {
+  case wrlKeywordHash("DEF"):
+    return wrlKeywordMatch(s,n,"DEF",WRL_DEF);
+  case wrlKeywordHash("USE"):
+    return wrlKeywordMatch(s,n,"USE",WRL_USE);
+  case wrlKeywordHash("Group"):
+    return wrlKeywordMatch(s,n,"Group",WRL_NODE_GROUP);
+  case wrlKeywordHash("Transform"):
+    return wrlKeywordMatch(s,n,"Transform",WRL_NODE_TRANSFORM);
+  case wrlKeywordHash("Shape"):
+    return wrlKeywordMatch(s,n,"Shape",WRL_NODE_SHAPE);
+  case wrlKeywordHash("Appearance"):
+    return wrlKeywordMatch(s,n,"Appearance",WRL_NODE_APPEARANCE);
+  case wrlKeywordHash("Material"):
+    return wrlKeywordMatch(s,n,"Material",WRL_NODE_MATERIAL);
+  case wrlKeywordHash("ImageTexture"):
+    return wrlKeywordMatch(s,n,"ImageTexture",WRL_NODE_IMAGE_TEXTURE);
+  case wrlKeywordHash("IndexedFaceSet"):
+    return wrlKeywordMatch(s,n,"IndexedFaceSet",WRL_NODE_INDEXED_FACE_SET);
+  case wrlKeywordHash("IndexedLineSet"):
+    return wrlKeywordMatch(s,n,"IndexedLineSet",WRL_NODE_INDEXED_LINE_SET);
+  case wrlKeywordHash("Color"):
+    return wrlKeywordMatch(s,n,"Color",WRL_NODE_COLOR);
+  case wrlKeywordHash("Coordinate"):
+    return wrlKeywordMatch(s,n,"Coordinate",WRL_NODE_COORDINATE);
+  case wrlKeywordHash("Normal"):
+    return wrlKeywordMatch(s,n,"Normal",WRL_NODE_NORMAL);
+  case wrlKeywordHash("TextureCoordinate"):
+    return wrlKeywordMatch(s,n,"TextureCoordinate",WRL_NODE_TEXTURE_COORDINATE);
+  case wrlKeywordHash("children"):
+    return wrlKeywordMatch(s,n,"children",WRL_FIELD_CHILDREN);
+  case wrlKeywordHash("bboxCenter"):
+    return wrlKeywordMatch(s,n,"bboxCenter",WRL_FIELD_BBOX_CENTER);
+  case wrlKeywordHash("bboxSize"):
+    return wrlKeywordMatch(s,n,"bboxSize",WRL_FIELD_BBOX_SIZE);
+  case wrlKeywordHash("center"):
+    return wrlKeywordMatch(s,n,"center",WRL_FIELD_CENTER);
+  case wrlKeywordHash("rotation"):
+    return wrlKeywordMatch(s,n,"rotation",WRL_FIELD_ROTATION);
+  case wrlKeywordHash("scale"):
+    return wrlKeywordMatch(s,n,"scale",WRL_FIELD_SCALE);
+  case wrlKeywordHash("scaleOrientation"):
+    return wrlKeywordMatch(s,n,"scaleOrientation",WRL_FIELD_SCALE_ORIENTATION);
+  case wrlKeywordHash("translation"):
+    return wrlKeywordMatch(s,n,"translation",WRL_FIELD_TRANSLATION);
+  case wrlKeywordHash("appearance"):
+    return wrlKeywordMatch(s,n,"appearance",WRL_FIELD_APPEARANCE);
+  case wrlKeywordHash("geometry"):
+    return wrlKeywordMatch(s,n,"geometry",WRL_FIELD_GEOMETRY);
+  case wrlKeywordHash("material"):
+    return wrlKeywordMatch(s,n,"material",WRL_FIELD_MATERIAL);
+  case wrlKeywordHash("texture"):
+    return wrlKeywordMatch(s,n,"texture",WRL_FIELD_TEXTURE);
+  case wrlKeywordHash("ambientIntensity"):
+    return wrlKeywordMatch(s,n,"ambientIntensity",WRL_FIELD_AMBIENT_INTENSITY);
+  case wrlKeywordHash("diffuseColor"):
+    return wrlKeywordMatch(s,n,"diffuseColor",WRL_FIELD_DIFFUSE_COLOR);
+  case wrlKeywordHash("emissiveColor"):
+    return wrlKeywordMatch(s,n,"emissiveColor",WRL_FIELD_EMISSIVE_COLOR);
+  case wrlKeywordHash("shininess"):
+    return wrlKeywordMatch(s,n,"shininess",WRL_FIELD_SHININESS);
+  case wrlKeywordHash("specularColor"):
+    return wrlKeywordMatch(s,n,"specularColor",WRL_FIELD_SPECULAR_COLOR);
+  case wrlKeywordHash("transparency"):
+    return wrlKeywordMatch(s,n,"transparency",WRL_FIELD_TRANSPARENCY);
+  case wrlKeywordHash("url"):
+    return wrlKeywordMatch(s,n,"url",WRL_FIELD_URL);
+  case wrlKeywordHash("repeatS"):
+    return wrlKeywordMatch(s,n,"repeatS",WRL_FIELD_REPEAT_S);
+  case wrlKeywordHash("repeatT"):
+    return wrlKeywordMatch(s,n,"repeatT",WRL_FIELD_REPEAT_T);
+  case wrlKeywordHash("color"):
+    return wrlKeywordMatch(s,n,"color",WRL_FIELD_COLOR);
+  case wrlKeywordHash("coord"):
+    return wrlKeywordMatch(s,n,"coord",WRL_FIELD_COORD);
+  case wrlKeywordHash("normal"):
+    return wrlKeywordMatch(s,n,"normal",WRL_FIELD_NORMAL);
+  case wrlKeywordHash("texCoord"):
+    return wrlKeywordMatch(s,n,"texCoord",WRL_FIELD_TEX_COORD);
+  case wrlKeywordHash("ccw"):
+    return wrlKeywordMatch(s,n,"ccw",WRL_FIELD_CCW);
+  case wrlKeywordHash("colorIndex"):
+    return wrlKeywordMatch(s,n,"colorIndex",WRL_FIELD_COLOR_INDEX);
+  case wrlKeywordHash("colorPerVertex"):
+    return wrlKeywordMatch(s,n,"colorPerVertex",WRL_FIELD_COLOR_PER_VERTEX);
+  case wrlKeywordHash("convex"):
+    return wrlKeywordMatch(s,n,"convex",WRL_FIELD_CONVEX);
+  case wrlKeywordHash("coordIndex"):
+    return wrlKeywordMatch(s,n,"coordIndex",WRL_FIELD_COORD_INDEX);
+  case wrlKeywordHash("creaseAngle"):
+    return wrlKeywordMatch(s,n,"creaseAngle",WRL_FIELD_CREASE_ANGLE);
+  case wrlKeywordHash("normalIndex"):
+    return wrlKeywordMatch(s,n,"normalIndex",WRL_FIELD_NORMAL_INDEX);
+  case wrlKeywordHash("normalPerVertex"):
+    return wrlKeywordMatch(s,n,"normalPerVertex",WRL_FIELD_NORMAL_PER_VERTEX);
+  case wrlKeywordHash("solid"):
+    return wrlKeywordMatch(s,n,"solid",WRL_FIELD_SOLID);
+  case wrlKeywordHash("texCoordIndex"):
+    return wrlKeywordMatch(s,n,"texCoordIndex",WRL_FIELD_TEX_COORD_INDEX);
+  case wrlKeywordHash("point"):
+    return wrlKeywordMatch(s,n,"point",WRL_FIELD_POINT);
+  case wrlKeywordHash("vector"):
+    return wrlKeywordMatch(s,n,"vector",WRL_FIELD_VECTOR);
+  default:
+    return WRL_UNKNOWN;
+  }
+}
+
+inline WrlKeyword wrlKeyword(const string& token) {
+  return wrlKeyword(token.data(),token.size());
+}
+
+inline WrlKeyword wrlKeyword(const string_view token) {
+  return wrlKeyword(token.data(),token.size());
+}
+
+#endif /* _WRL_KEYWORD_HPP_ */
@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// Wrlb.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef _WRLB_HPP_
+#define _WRLB_HPP_
+
+// .wrlb is a binary cache of the SceneGraph, written by SaverWrlb and
+// read back by LoaderWrlb; all values are stored in the byte order of
+// the machine which wrote the file, and a file written on a machine
+// with a different byte order is rejected
+//
+// file     : "WRLB" uint32 version uint32 byteOrder
+//            string name uint32 nChildren node[nChildren]
+// string   : uint32 length char[length], zero padded to 4 bytes
+// array    : zero padding to 8 bytes, uint64 n, (float|int32)[n]
+// node     : uint32 type string name, followed by the fields, or
+//            uint32 WRLB_USE uint32 index for a node already written
+//
+// Group          : float bboxCenter[3] bboxSize[3]
+//                  uint32 nChildren node[nChildren]
+// Transform      : float center[3] rotation[4] scale[3]
+//                  scaleOrientation[4] translation[3]
+//                  bboxCenter[3] bboxSize[3]
+//                  uint32 nChildren node[nChildren]
+// Shape          : node appearance, node geometry
+// Appearance     : node material, node texture
+// Material       : float ambientIntensity diffuseColor[3]
+//                  emissiveColor[3] shininess specularColor[3]
+//                  transparency
+// ImageTexture   : uint32 repeatS repeatT nUrl string url[nUrl]
+// IndexedFaceSet : uint32 flags float creaseAngle
+//                  array coord coordIndex normal normalIndex
+//                  color colorIndex texCoord texCoordIndex
+// IndexedLineSet : uint32 colorPerVertex
+//                  array coord coordIndex color colorIndex
+//
+// the nodes are numbered from 0 in the order in which their type is
+// written; a node shared by several parents, as with DEF/USE, is
+// written in full the first time, and as a WRLB_USE reference to its
+// number after that, so that the loader shares it as well
+//
+// missing nodes are stored as a single uint32 WRLB_NULL; since arrays
+// start at 8 byte boundaries, they can be copied directly from a
+// memory mapped file into the vectors of the nodes
+
+#define WRLB_MAGIC      "WRLB"
+#define WRLB_VERSION    2  // version 1 files have no WRLB_USE records
+#define WRLB_BYTE_ORDER 0x01020304
+
+enum WrlbNodeType {
+  WRLB_NULL             = 0,
+  WRLB_GROUP            = 1,
+  WRLB_TRANSFORM        = 2,
+  WRLB_SHAPE            = 3,
+  WRLB_APPEARANCE       = 4,
+  WRLB_MATERIAL         = 5,
+  WRLB_IMAGE_TEXTURE    = 6,
+  WRLB_INDEXED_FACE_SET = 7,
+  WRLB_INDEXED_LINE_SET = 8,
+  WRLB_USE              = 9
+};
+
+// IndexedFaceSet flags
+#define WRLB_CCW               0x01
+#define WRLB_CONVEX            0x02
+#define WRLB_SOLID             0x04
+#define WRLB_NORMAL_PER_VERTEX 0x08
+#define WRLB_COLOR_PER_VERTEX  0x10
+
+#endif /* _WRLB_HPP_ */
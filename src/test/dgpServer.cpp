@@ -0,0 +1,499 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// dgpServer.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <vector>
+#include "dgpServer.hpp"
+#include <wrl/SceneGraphProcessor.hpp>
+#include <wrl/Transform.hpp>
+#include <wrl/Appearance.hpp>
+#include <wrl/Material.hpp>
+#include <wrl/ImageTexture.hpp>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
+// requests longer than this are rejected
+#define DGP_SERVER_MAX_REQUEST (1<<16)
+
+DgpServer::DgpServer
+(AppLoader& loaderFactory, AppSaver& saverFactory,
+ const FloatFormat& format, const size_t nJobs,
+ const size_t cacheSize, const bool debug):
+  _loaderFactory(loaderFactory),
+  _saverFactory(saverFactory),
+  _format(format),
+  _nJobs((nJobs>0)?nJobs:1),
+  _cacheSize(cacheSize),
+  _debug(debug),
+  _quit(false) {
+}
+
+DgpServer::~DgpServer() {
+}
+
+#ifndef _WIN32
+
+// reads up to the first end of line, which is not included
+static bool readLine(int fd, string& line) {
+  line.clear();
+  char c;
+  ssize_t n;
+  while((n=read(fd,&c,1))==1 || (n<0 && errno==EINTR)) {
+    if(n<0) continue;
+    if(c=='\n') return true;
+    if(line.size()>=DGP_SERVER_MAX_REQUEST) return false;
+    line += c;
+  }
+  return line.size()>0;
+}
+
+static bool writeAll(int fd, const string& str) {
+  const char* p = str.data();
+  size_t n = str.size();
+  while(n>0) {
+    ssize_t w = write(fd,p,n);
+    if(w<0 && errno==EINTR) continue;
+    if(w<=0) return false;
+    p += w;
+    n -= (size_t)w;
+  }
+  return true;
+}
+
+static bool socketAddress(const char* socketPath, sockaddr_un& addr) {
+  memset(&addr,0,sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if(socketPath==(const char*)0 || strlen(socketPath)>=sizeof(addr.sun_path))
+    return false;
+  strcpy(addr.sun_path,socketPath);
+  return true;
+}
+
+static vector<string> splitTabs(const string& line) {
+  vector<string> field;
+  size_t b = 0, e;
+  while((e=line.find('\t',b))!=string::npos) {
+    field.push_back(line.substr(b,e-b));
+    b = e+1;
+  }
+  field.push_back(line.substr(b));
+  return field;
+}
+
+//////////////////////////////////////////////////////////////////////
+// returns the SceneGraph of the file, from the cache if the file has
+// not changed since it was loaded, or null if it can not be loaded
+shared_ptr<SceneGraph> DgpServer::load(const string& filename, bool& cached) {
+  cached = false;
+  error_code ec;
+  const long long mtime = (long long)
+    filesystem::last_write_time(filename,ec).time_since_epoch().count();
+  if(ec) return shared_ptr<SceneGraph>();
+  const long long size = (long long)filesystem::file_size(filename,ec);
+  if(ec) return shared_ptr<SceneGraph>();
+
+  if(_cacheSize>0) {
+    lock_guard<mutex> lock(_cacheMutex);
+    map<string,list<CacheEntry>::iterator>::iterator it =
+      _cacheIndex.find(filename);
+    if(it!=_cacheIndex.end()) {
+      if(it->second->mtime==mtime && it->second->size==size) {
+        _cache.splice(_cache.begin(),_cache,it->second);
+        cached = true;
+        return _cache.front().wrl;
+      }
+      _cache.erase(it->second);
+      _cacheIndex.erase(it);
+    }
+  }
+
+  // several workers may load the same file at once; the last one to
+  // finish replaces the cache entry
+  shared_ptr<SceneGraph> wrl(new SceneGraph());
+  if(_loaderFactory.load(filename.c_str(),*wrl)==false)
+    return shared_ptr<SceneGraph>();
+
+  if(_cacheSize>0) {
+    lock_guard<mutex> lock(_cacheMutex);
+    map<string,list<CacheEntry>::iterator>::iterator it =
+      _cacheIndex.find(filename);
+    if(it!=_cacheIndex.end()) {
+      _cache.erase(it->second);
+      _cacheIndex.erase(it);
+    }
+    CacheEntry entry;
+    entry.filename = filename;
+    entry.mtime    = mtime;
+    entry.size     = size;
+    entry.wrl      = wrl;
+    _cache.push_front(entry);
+    _cacheIndex[filename] = _cache.begin();
+    while(_cache.size()>_cacheSize) {
+      _cacheIndex.erase(_cache.back().filename);
+      _cache.pop_back();
+    }
+  }
+  return wrl;
+}
+
+//////////////////////////////////////////////////////////////////////
+// deep copy of a cached SceneGraph, on which operations can be run;
+// nodes shared in the source are shared in the copy as well
+
+typedef map<Node*,Node*> CopyMap;
+
+static Node* copyNode(Node* node, CopyMap& copied);
+
+static void copyGroup(Group& src, Group& dst, CopyMap& copied) {
+  dst.setBBoxCenter(src.getBBoxCenter());
+  dst.setBBoxSize(src.getBBoxSize());
+  for(Node* child : src.getChildren()) {
+    Node* copy = copyNode(child,copied);
+    if(copy!=(Node*)0) dst.addChild(copy);
+  }
+}
+
+static Node* copyNode(Node* node, CopyMap& copied) {
+  if(node==(Node*)0) return (Node*)0;
+  CopyMap::iterator i = copied.find(node);
+  if(i!=copied.end()) return i->second;
+
+  Node* copy = (Node*)0;
+  if(node->isTransform()) {
+    Transform& src = *((Transform*)node);
+    Transform* dst = new Transform();
+    dst->setCenter(src.getCenter());
+    dst->setRotation(src.getRotation());
+    dst->setScale(src.getScale());
+    dst->setScaleOrientation(src.getScaleOrientation());
+    dst->setTranslation(src.getTranslation());
+    copy = dst;
+  } else if(node->isGroup()) {
+    copy = new Group();
+  } else if(node->isShape()) {
+    copy = new Shape();
+  } else if(node->isAppearance()) {
+    copy = new Appearance();
+  } else if(node->isMaterial()) {
+    Material& src = *((Material*)node);
+    Material* dst = new Material();
+    Color specularColor = src.getSpecularColor();
+    dst->setAmbientIntensity(src.getAmbientIntensity());
+    dst->setDiffuseColor(src.getDiffuseColor());
+    dst->setEmissiveColor(src.getEmissiveColor());
+    dst->setShininess(src.getShininess());
+    dst->setSpecularColor(specularColor);
+    dst->setTransparency(src.getTransparency());
+    copy = dst;
+  } else if(node->isImageTexture()) {
+    ImageTexture& src = *((ImageTexture*)node);
+    ImageTexture* dst = new ImageTexture();
+    dst->getUrl() = src.getUrl();
+    dst->setRepeatS(src.getRepeatS());
+    dst->setRepeatT(src.getRepeatT());
+    copy = dst;
+  } else if(node->isIndexedFaceSet()) {
+    IndexedFaceSet& src = *((IndexedFaceSet*)node);
+    IndexedFaceSet* dst = new IndexedFaceSet();
+    dst->getCcw()             = src.getCcw();
+    dst->getConvex()          = src.getConvex();
+    dst->getCreaseangle()     = src.getCreaseangle();
+    dst->getSolid()           = src.getSolid();
+    dst->getNormalPerVertex() = src.getNormalPerVertex();
+    dst->getColorPerVertex()  = src.getColorPerVertex();
+    dst->getCoord()           = src.getCoord();
+    dst->getCoordIndex()      = src.getCoordIndex();
+    dst->getNormal()          = src.getNormal();
+    dst->getNormalIndex()     = src.getNormalIndex();
+    dst->getColor()           = src.getColor();
+    dst->getColorIndex()      = src.getColorIndex();
+    dst->getTexCoord()        = src.getTexCoord();
+    dst->getTexCoordIndex()   = src.getTexCoordIndex();
+    copy = dst;
+  } else if(node->isIndexedLineSet()) {
+    IndexedLineSet& src = *((IndexedLineSet*)node);
+    IndexedLineSet* dst = new IndexedLineSet();
+    dst->getColorPerVertex()  = src.getColorPerVertex();
+    dst->getCoord()           = src.getCoord();
+    dst->getCoordIndex()      = src.getCoordIndex();
+    dst->getColor()           = src.getColor();
+    dst->getColorIndex()      = src.getColorIndex();
+    copy = dst;
+  } else {
+    // no other node types are created by the loaders
+    return (Node*)0;
+  }
+  copy->setName(node->getName());
+  copy->setShow(node->getShow());
+  copied[node] = copy;
+
+  // children are copied once the node is in the map, and each one is
+  // ref()'ed by its new parent
+  if(node->isGroup()) {
+    copyGroup(*((Group*)node),*((Group*)copy),copied);
+  } else if(node->isShape()) {
+    Shape* src = (Shape*)node;
+    Shape* dst = (Shape*)copy;
+    Node* appearance = copyNode(src->getAppearance(),copied);
+    Node* geometry   = copyNode(src->getGeometry(),copied);
+    if(appearance!=(Node*)0) dst->setAppearance(appearance);
+    if(geometry!=(Node*)0)   dst->setGeometry(geometry);
+  } else if(node->isAppearance()) {
+    Appearance* src = (Appearance*)node;
+    Appearance* dst = (Appearance*)copy;
+    Node* material = copyNode(src->getMaterial(),copied);
+    Node* texture  = copyNode(src->getTexture(),copied);
+    if(material!=(Node*)0) dst->setMaterial(material);
+    if(texture!=(Node*)0)  dst->setTexture(texture);
+  }
+  return copy;
+}
+
+static shared_ptr<SceneGraph> copySceneGraph(SceneGraph& src) {
+  shared_ptr<SceneGraph> dst(new SceneGraph());
+  dst->setName(src.getName());
+  dst->setUrl(src.getUrl());
+  CopyMap copied;
+  copyGroup(src,*dst,copied);
+  return dst;
+}
+
+//////////////////////////////////////////////////////////////////////
+string DgpServer::convert
+(const string& inFile, const string& outFile, const vector<string>& ops) {
+  typedef chrono::steady_clock Clock;
+  Clock::time_point t0 = Clock::now();
+  bool cached = false;
+  shared_ptr<SceneGraph> wrl = load(inFile,cached);
+  Clock::time_point t1 = Clock::now();
+  bool success = (wrl.get()!=(SceneGraph*)0);
+  if(success && ops.size()>0) {
+    // the cached SceneGraph may be in use by other workers
+    shared_ptr<SceneGraph> copy = copySceneGraph(*wrl);
+    SceneGraphProcessor processor(*copy);
+    for(const string& op : ops)
+      processor.apply(op);
+    wrl = copy;
+  }
+  if(success)
+    success = _saverFactory.save(outFile.c_str(),*wrl,_format);
+  Clock::time_point t2 = Clock::now();
+
+  double tLoad = chrono::duration<double,milli>(t1-t0).count();
+  double tSave = chrono::duration<double,milli>(t2-t1).count();
+  {
+    lock_guard<mutex> lock(_logMutex);
+    fprintf(stdout,"%s %9.2f ms %9.2f ms %s %s -> %s\n",
+            (success)?"OK    ":"FAILED",tLoad,tSave,
+            (cached)?"cached":"loaded",inFile.c_str(),outFile.c_str());
+    fflush(stdout);
+  }
+
+  char response[256];
+  if(wrl.get()==(SceneGraph*)0)
+    snprintf(response,sizeof(response),"FAILED\tunable to load inFile\n");
+  else if(success==false)
+    snprintf(response,sizeof(response),"FAILED\tunable to save outFile\n");
+  else
+    snprintf(response,sizeof(response),"OK\t%.2f\t%.2f\t%s\n",
+             tLoad,tSave,(cached)?"cached":"loaded");
+  return string(response);
+}
+
+//////////////////////////////////////////////////////////////////////
+void DgpServer::serve(int fd) {
+  string request;
+  if(readLine(fd,request)==false) return;
+  vector<string> field = splitTabs(request);
+  string response;
+  if(field[0]=="convert" && field.size()>=3) {
+    vector<string> ops(field.begin()+3,field.end());
+    for(const string& op : ops) {
+      if(SceneGraphProcessor::isOperation(op)==false) {
+        response = "FAILED\tunknown operation "+op+"\n";
+        break;
+      }
+    }
+    if(response=="")
+      response = convert(field[1],field[2],ops);
+  } else if(field[0]=="quit" && field.size()==1) {
+    _quit = true;
+    response = "OK\n";
+  } else {
+    response = "FAILED\tunknown request\n";
+  }
+  writeAll(fd,response);
+}
+
+void DgpServer::work() {
+  for(;;) {
+    int fd;
+    {
+      unique_lock<mutex> lock(_queueMutex);
+      _queueReady.wait(lock,[this]() { return _queue.size()>0 || _quit; });
+      if(_queue.size()==0) return;
+      fd = _queue.front();
+      _queue.pop_front();
+    }
+    serve(fd);
+    close(fd);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+bool DgpServer::run(const char* socketPath) {
+  sockaddr_un addr;
+  if(socketAddress(socketPath,addr)==false) return false;
+
+  // clients which disconnect early should not terminate the server
+  signal(SIGPIPE,SIG_IGN);
+
+  // only a stale socket left by a previous server is removed
+  struct stat st;
+  if(lstat(socketPath,&st)==0) {
+    if(S_ISSOCK(st.st_mode)==false) {
+      fprintf(stderr,"ERROR | %s exists and is not a socket\n",socketPath);
+      return false;
+    }
+    unlink(socketPath);
+  }
+
+  int listenFd = socket(AF_UNIX,SOCK_STREAM,0);
+  if(listenFd<0) return false;
+  if(bind(listenFd,(sockaddr*)&addr,sizeof(addr))!=0 ||
+     listen(listenFd,64)!=0) {
+    close(listenFd);
+    return false;
+  }
+
+  if(_debug) {
+    fprintf(stderr,"  listening on %s with %zu jobs and %zu cache entries\n",
+            socketPath,_nJobs,_cacheSize);
+    fflush(stderr);
+  }
+
+  vector<thread> workers;
+  for(size_t k=0;k<_nJobs;k++)
+    workers.emplace_back([this]() { work(); });
+
+  // the socket is polled, so that a quit request handled by a worker
+  // is noticed without another connection
+  while(_quit==false) {
+    pollfd pfd;
+    pfd.fd      = listenFd;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+    if(poll(&pfd,1,200)<=0) continue;
+    int fd = accept(listenFd,(sockaddr*)0,(socklen_t*)0);
+    if(fd<0) continue;
+    timeval timeout = { 30, 0 };
+    setsockopt(fd,SOL_SOCKET,SO_RCVTIMEO,&timeout,sizeof(timeout));
+    lock_guard<mutex> lock(_queueMutex);
+    _queue.push_back(fd);
+    _queueReady.notify_one();
+  }
+
+  // the connections already accepted are served before returning
+  close(listenFd);
+  unlink(socketPath);
+  {
+    lock_guard<mutex> lock(_queueMutex);
+    _queueReady.notify_all();
+  }
+  for(thread& worker : workers)
+    worker.join();
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+bool DgpServer::submit
+(const char* socketPath, const string& request, string& response) {
+  response.clear();
+  sockaddr_un addr;
+  if(socketAddress(socketPath,addr)==false) return false;
+  int fd = socket(AF_UNIX,SOCK_STREAM,0);
+  if(fd<0) return false;
+  bool success =
+    connect(fd,(sockaddr*)&addr,sizeof(addr))==0 &&
+    writeAll(fd,request+"\n") &&
+    readLine(fd,response);
+  close(fd);
+  return success;
+}
+
+#else /* _WIN32 */
+
+// Unix domain sockets are not available
+
+bool DgpServer::run(const char* /*socketPath*/) {
+  return false;
+}
+
+bool DgpServer::submit
+(const char* /*socketPath*/, const string& /*request*/, string& response) {
+  response.clear();
+  return false;
+}
+
+void DgpServer::work() {
+}
+
+void DgpServer::serve(int /*fd*/) {
+}
+
+string DgpServer::convert
+(const string& /*inFile*/, const string& /*outFile*/,
+ const vector<string>& /*ops*/) {
+  return string();
+}
+
+shared_ptr<SceneGraph> DgpServer::load(const string& /*filename*/, bool& cached) {
+  cached = false;
+  return shared_ptr<SceneGraph>();
+}
+
+#endif /* _WIN32 */
@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// dgpServer.hpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef _DGP_SERVER_HPP_
+#define _DGP_SERVER_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <io/AppLoader.hpp>
+#include <io/AppSaver.hpp>
+
+using namespace std;
+
+// resident conversion server used by dgpTest1 -listen, which saves the
+// cost of starting a process and of loading the same files for each
+// conversion
+//
+// clients connect to a Unix domain socket and send a single request
+// line, with the fields separated by tabs, and receive a single
+// response line:
+//
+//   convert <TAB> inFile <TAB> outFile [<TAB> op ...]
+//                                        ->  OK <TAB> loadMs <TAB> saveMs <TAB> cached|loaded
+//                                        ->  FAILED <TAB> reason
+//   quit                                 ->  OK
+//
+// each op names a SceneGraphProcessor operation, as "edgesAdd" or
+// "computeNormalPerVertex", which is applied in the given order before
+// saving; saveMs includes the time spent processing
+//
+// file names should be absolute, since the server has its own working
+// directory; the connections are served by a pool of worker threads,
+// and the most recently loaded SceneGraphs are kept in an LRU cache,
+// keyed by file name and validated by modification time and size;
+// a cached SceneGraph may be saved by several workers at once, so
+// jobs with operations are run on a private copy of it
+
+class DgpServer {
+
+public:
+
+  DgpServer(AppLoader& loaderFactory, AppSaver& saverFactory,
+            const FloatFormat& format, const size_t nJobs,
+            const size_t cacheSize, const bool debug);
+  ~DgpServer();
+
+  // serves requests until a client sends quit; returns false if the
+  // socket could not be created
+  bool   run(const char* socketPath);
+
+  // sends the request line to the server, and returns false if the
+  // server could not be reached
+  static bool submit(const char* socketPath, const string& request,
+                     string& response);
+
+private:
+
+  class CacheEntry {
+  public:
+    string                 filename;
+    long long              mtime;
+    long long              size;
+    shared_ptr<SceneGraph> wrl;
+  };
+
+  AppLoader&             _loaderFactory;
+  AppSaver&              _saverFactory;
+  FloatFormat            _format;
+  size_t                 _nJobs;
+  size_t                 _cacheSize;
+  bool                   _debug;
+
+  // connections waiting for a worker
+  deque<int>             _queue;
+  mutex                  _queueMutex;
+  condition_variable     _queueReady;
+  atomic<bool>           _quit;
+
+  // most recently used first
+  list<CacheEntry>                              _cache;
+  map<string,list<CacheEntry>::iterator>        _cacheIndex;
+  mutex                                         _cacheMutex;
+
+  mutex                  _logMutex;
+
+  void   work();
+  void   serve(int fd);
+  string convert(const string& inFile, const string& outFile,
+                 const vector<string>& ops);
+  shared_ptr<SceneGraph> load(const string& filename, bool& cached);
+
+};
+
+#endif /* _DGP_SERVER_HPP_ */
@@ -34,25 +34,72 @@
 
 #include <string>
 #include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
 #include <wrl/SceneGraph.hpp>
+#include <wrl/SceneGraphProcessor.hpp>
 #include <io/AppLoader.hpp>
 #include <io/AppSaver.hpp>
+#include <io/LoaderObj.hpp>
+#include <io/LoaderPly.hpp>
 #include <io/LoaderStl.hpp>
+#include <io/LoaderWrlb.hpp>
 #include <io/LoaderWrl.hpp>
 #include <io/SaverWrl.hpp>
+#include <io/SaverGlb.hpp>
+#include <io/SaverPly.hpp>
 #include <io/SaverStl.hpp>
+#include <io/SaverWrlb.hpp>
+#include "dgpServer.hpp"
 
 class Data {
 public:
   bool   _debug;
+  bool   _binary;
+  bool   _compact;
+  bool   _stream;
+  bool   _batch;
+  bool   _weld;
+  float  _tolerance;
+  int    _threads;
+  int    _jobs;
+  string _listen;
+  string _connect;
+  int    _cache;
+  bool   _quit;
+  int    _digits;
+  bool   _shortest;
+  float  _quantize;
+  vector<string> _ops;
   string _inFile;
   string _outFile;
 public:
   Data():
     _debug(false),
+    _binary(false),
+    _compact(false),
+    _stream(false),
+    _batch(false),
+    _weld(false),
+    _tolerance(0.0f),
+    _threads(1),
+    _jobs(1),
+    _listen(""),
+    _connect(""),
+    _cache(8),
+    _quit(false),
+    _digits(-1),
+    _shortest(false),
+    _quantize(0.0f),
     _inFile(""),
     _outFile("")
   { }
@@ -62,13 +109,42 @@ const char* tv(bool value)        { return (value)?"true":"false";
 
 void options(Data& D) {
   cerr << "   -d|-debug               [" << tv(D._debug)          << "]" << endl;
+  cerr << "   -b|-binary              [" << tv(D._binary)         << "]" << endl;
+  cerr << "   -c|-compact             [" << tv(D._compact)        << "]" << endl;
+  cerr << "   -S|-stream              [" << tv(D._stream)         << "]" << endl;
+  cerr << "   -w|-weld                [" << tv(D._weld)           << "]" << endl;
+  cerr << "   -t|-tolerance <float>   [" << D._tolerance          << "]" << endl;
+  cerr << "   -j|-threads <int>       [" << D._threads            << "]" << endl;
+  cerr << "   -B|-batch               [" << tv(D._batch)          << "]" << endl;
+  cerr << "   -J|-jobs <int>          [" << D._jobs               << "]" << endl;
+  cerr << "   -listen <socket>        [" << D._listen             << "]" << endl;
+  cerr << "   -cache <int>            [" << D._cache              << "]" << endl;
+  cerr << "   -connect <socket>       [" << D._connect            << "]" << endl;
+  cerr << "   -quit                   [" << tv(D._quit)           << "]" << endl;
+  cerr << "   -p|-digits <int>        [" << D._digits             << "]" << endl;
+  cerr << "   -s|-shortest            [" << tv(D._shortest)       << "]" << endl;
+  cerr << "   -q|-quantize <float>    [" << D._quantize           << "]" << endl;
+  cerr << "   -op <operation>         [";
+  for(size_t i=0;i<D._ops.size();i++) cerr << ((i>0)?" ":"") << D._ops[i];
+  cerr << "]" << endl;
 }
 
 void usage(Data& D) {
   cerr << "USAGE: dgpTest1 [options] inFile outFile" << endl;
+  cerr << "       dgpTest1 -B [options] inDir|inList outPattern" << endl;
+  cerr << "       dgpTest1 -listen socket [options]" << endl;
+  cerr << "       dgpTest1 -connect socket [-op operation ...] inFile outFile" << endl;
+  cerr << "       dgpTest1 -connect socket -quit" << endl;
   cerr << "   -h|-help" << endl;
   options(D);
   cerr << endl;
+  cerr << "   -op may be repeated; operations are applied in order after" << endl;
+  cerr << "   loading, and are named as the SceneGraphProcessor methods" << endl;
+  cerr << "   normalClear, normalInvert, computeNormalPerFace," << endl;
+  cerr << "   computeNormalPerVertex, computeNormalPerCorner, bboxAdd," << endl;
+  cerr << "   bboxRemove, edgesAdd, edgesRemove, pointsRemove, surfaceRemove," << endl;
+  cerr << "   shapeIndexedFaceSetShow|Hide, shapeIndexedLineSetShow|Hide" << endl;
+  cerr << endl;
   exit(0);
 }
 
@@ -77,6 +153,143 @@ void error(const char *msg) {
   exit(0);
 }
 
+//////////////////////////////////////////////////////////////////////
+// batch mode
+//
+// inFile is either a directory, whose files with a registered loader
+// are converted, or a text file with one input file name per line;
+// outFile is a pattern in which "%s" is replaced by the input file name
+// without its directory and extension, as in "out/%s.ply"; the files
+// are converted on D._jobs worker threads, each one with its own
+// SceneGraph, sharing the loader and saver registries
+
+vector<string> batchFiles(Data& D, AppLoader& loaderFactory) {
+  vector<string> files;
+  error_code ec;
+  if(filesystem::is_directory(D._inFile,ec)) {
+    for(const filesystem::directory_entry& entry :
+          filesystem::directory_iterator(D._inFile,ec)) {
+      string file = entry.path().string();
+      if(entry.is_regular_file(ec) &&
+         loaderFactory.getLoader(file.c_str())!=(Loader*)0)
+        files.push_back(file);
+    }
+    sort(files.begin(),files.end());
+  } else {
+    ifstream list(D._inFile);
+    if(list.is_open()==false) error("unable to open inFile");
+    string line;
+    while(getline(list,line)) {
+      while(line.size()>0 && isspace((unsigned char)line.back())) line.pop_back();
+      if(line.size()>0 && line[0]!='#') files.push_back(line);
+    }
+  }
+  return files;
+}
+
+string batchOutFile(const string& pattern, const string& inFile) {
+  string name = filesystem::path(inFile).filename().string();
+  // compressed files lose both extensions, as in "mesh.wrl.gz"
+  size_t dot = name.find_last_of('.');
+  if(dot!=string::npos && dot>0 && name.substr(dot)==".gz")
+    name.erase(dot);
+  dot = name.find_last_of('.');
+  if(dot!=string::npos && dot>0) name.erase(dot);
+  string outFile = pattern;
+  size_t pos = outFile.find("%s");
+  if(pos!=string::npos) outFile.replace(pos,2,name);
+  return outFile;
+}
+
+int batch(Data& D, AppLoader& loaderFactory, AppSaver& saverFactory,
+          const FloatFormat& format) {
+  typedef chrono::steady_clock Clock;
+
+  if(D._outFile.find("%s")==string::npos)
+    error("batch outFile should be a pattern containing %s");
+  vector<string> files = batchFiles(D,loaderFactory);
+  // workers writing to the same file would corrupt it
+  vector<string> outFiles;
+  for(const string& inFile : files)
+    outFiles.push_back(batchOutFile(D._outFile,inFile));
+  sort(outFiles.begin(),outFiles.end());
+  vector<string>::iterator dup = adjacent_find(outFiles.begin(),outFiles.end());
+  if(dup!=outFiles.end())
+    error(("several input files are saved to "+*dup).c_str());
+
+  size_t nJobs =
+    (D._jobs>0)?(size_t)D._jobs:(size_t)thread::hardware_concurrency();
+  if(nJobs<1) nJobs = 1;
+  if(nJobs>files.size()) nJobs = (files.size()>0)?files.size():1;
+
+  if(D._debug) {
+    cerr << "  batch {" << endl;
+    cerr << "    nFiles         = " << files.size() << endl;
+    cerr << "    nJobs          = " << nJobs        << endl;
+    cerr << "  }" << endl;
+    cerr << endl;
+  }
+
+  atomic<size_t> next(0);
+  atomic<size_t> nFailed(0);
+  double loadTime = 0.0, saveTime = 0.0;
+  mutex  outMutex;
+
+  Clock::time_point start = Clock::now();
+  vector<thread> workers;
+  for(size_t k=0;k<nJobs;k++) {
+    workers.emplace_back([&]() {
+      size_t i;
+      while((i=next++)<files.size()) {
+        const string& inFile = files[i];
+        string outFile = batchOutFile(D._outFile,inFile);
+        error_code ec;
+        filesystem::path dir = filesystem::path(outFile).parent_path();
+        if(dir.empty()==false) filesystem::create_directories(dir,ec);
+
+        Clock::time_point t0 = Clock::now();
+        SceneGraph wrl;
+        bool success = loaderFactory.load(inFile.c_str(),wrl);
+        Clock::time_point t1 = Clock::now();
+        // as in the server, the save time includes the processing
+        if(success && D._ops.size()>0) {
+          SceneGraphProcessor processor(wrl);
+          for(const string& op : D._ops)
+            processor.apply(op);
+        }
+        if(success)
+          success = saverFactory.save(outFile.c_str(),wrl,format);
+        Clock::time_point t2 = Clock::now();
+
+        double tLoad = chrono::duration<double,milli>(t1-t0).count();
+        double tSave = chrono::duration<double,milli>(t2-t1).count();
+        if(success==false) nFailed++;
+        lock_guard<mutex> lock(outMutex);
+        loadTime += tLoad;
+        saveTime += tSave;
+        fprintf(stdout,"%s %9.2f ms %9.2f ms  %s -> %s\n",
+                (success)?"OK    ":"FAILED",tLoad,tSave,
+                inFile.c_str(),outFile.c_str());
+        fflush(stdout);
+      }
+    });
+  }
+  for(thread& worker : workers)
+    worker.join();
+  double wallTime =
+    chrono::duration<double,milli>(Clock::now()-start).count();
+
+  fprintf(stdout,"files %zu failed %zu jobs %zu\n",
+          files.size(),(size_t)nFailed,nJobs);
+  fprintf(stdout,"load %.2f ms save %.2f ms wall %.2f ms",
+          loadTime,saveTime,wallTime);
+  if(wallTime>0.0)
+    fprintf(stdout," (%.1f files/s)",1000.0*files.size()/wallTime);
+  fprintf(stdout,"\n");
+
+  return (nFailed==0)?0:-1;
+}
+
 //////////////////////////////////////////////////////////////////////
 int main(int argc, char **argv) {
 
@@ -89,6 +302,51 @@ int main(int argc, char **argv) {
       usage(D);
     } else if(string(argv[i])=="-d" || string(argv[i])=="-debug") {
       D._debug = !D._debug;
+    } else if(string(argv[i])=="-b" || string(argv[i])=="-binary") {
+      D._binary = !D._binary;
+    } else if(string(argv[i])=="-c" || string(argv[i])=="-compact") {
+      D._compact = !D._compact;
+    } else if(string(argv[i])=="-S" || string(argv[i])=="-stream") {
+      D._stream = !D._stream;
+    } else if(string(argv[i])=="-w" || string(argv[i])=="-weld") {
+      D._weld = !D._weld;
+    } else if(string(argv[i])=="-t" || string(argv[i])=="-tolerance") {
+      if(++i>=argc) error("missing tolerance value");
+      D._tolerance = static_cast<float>(atof(argv[i]));
+    } else if(string(argv[i])=="-j" || string(argv[i])=="-threads") {
+      if(++i>=argc) error("missing number of threads");
+      D._threads = atoi(argv[i]);
+    } else if(string(argv[i])=="-B" || string(argv[i])=="-batch") {
+      D._batch = !D._batch;
+    } else if(string(argv[i])=="-J" || string(argv[i])=="-jobs") {
+      if(++i>=argc) error("missing number of jobs");
+      D._jobs = atoi(argv[i]);
+    } else if(string(argv[i])=="-listen") {
+      if(++i>=argc) error("missing socket name");
+      D._listen = string(argv[i]);
+    } else if(string(argv[i])=="-cache") {
+      if(++i>=argc) error("missing number of cache entries");
+      D._cache = atoi(argv[i]);
+    } else if(string(argv[i])=="-connect") {
+      if(++i>=argc) error("missing socket name");
+      D._connect = string(argv[i]);
+    } else if(string(argv[i])=="-quit") {
+      D._quit = !D._quit;
+    } else if(string(argv[i])=="-p" || string(argv[i])=="-digits") {
+      if(++i>=argc) error("missing number of digits");
+      D._digits = atoi(argv[i]);
+      if(D._digits<0 || D._digits>FLOAT_FORMAT_MAX_DIGITS)
+        error("number of digits should be in [0,9]");
+    } else if(string(argv[i])=="-s" || string(argv[i])=="-shortest") {
+      D._shortest = !D._shortest;
+    } else if(string(argv[i])=="-q" || string(argv[i])=="-quantize") {
+      if(++i>=argc) error("missing quantization tolerance");
+      D._quantize = static_cast<float>(atof(argv[i]));
+    } else if(string(argv[i])=="-op") {
+      if(++i>=argc) error("missing operation");
+      if(SceneGraphProcessor::isOperation(argv[i])==false)
+        error("unknown operation");
+      D._ops.push_back(string(argv[i]));
     } else if(string(argv[i])[0]=='-') {
       error("unknown option");
     } else if(D._inFile=="") {
@@ -98,9 +356,38 @@ int main(int argc, char **argv) {
     }
   }
 
+  // submit a job to a server /////////////////////////////////////////
+  if(D._connect!="") {
+    string request;
+    if(D._quit) {
+      request = "quit";
+    } else {
+      if(D._inFile =="") error("no inFile");
+      if(D._outFile=="") error("no outFile");
+      // the server does not share our working directory
+      error_code ec;
+      request = "convert\t"+
+        filesystem::absolute(D._inFile,ec).string()+"\t"+
+        filesystem::absolute(D._outFile,ec).string();
+      for(const string& op : D._ops)
+        request += "\t"+op;
+    }
+    string response;
+    if(DgpServer::submit(D._connect.c_str(),request,response)==false)
+      error("unable to reach server");
+    cout << response << endl;
+    return (response.compare(0,2,"OK")==0)?0:-1;
+  }
+
   // basic error handling //////////////////////////////////////////////
-  if(D._inFile =="") error("no inFile");
-  if(D._outFile=="") error("no outFile");
+  if(D._listen=="") {
+    if(D._inFile =="") error("no inFile");
+    if(D._outFile=="") error("no outFile");
+  } else if(D._batch || D._stream) {
+    error("server mode can not be combined with batch or stream modes");
+  } else if(D._ops.size()>0) {
+    error("operations are sent by the clients with each job");
+  }
 
   if(D._debug) {
     cerr << "dgpTest {" << endl;
@@ -124,15 +411,96 @@ int main(int argc, char **argv) {
 
   // register input file loaders
   LoaderWrl* wrlLoader = new LoaderWrl();
+  wrlLoader->setNumberOfThreads(D._threads);
   loaderFactory.registerLoader(wrlLoader);
+  loaderFactory.registerLoader(wrlLoader,"wrz");
+  loaderFactory.registerLoader(wrlLoader,"wrl.gz");
   LoaderStl* stlLoader = new LoaderStl();
+  stlLoader->setWeld(D._weld);
+  stlLoader->setWeldTolerance(D._tolerance);
+  stlLoader->setNumberOfThreads(D._threads);
   loaderFactory.registerLoader(stlLoader);
+  loaderFactory.registerLoader(stlLoader,"stl.gz");
+  LoaderWrlb* wrlbLoader = new LoaderWrlb();
+  loaderFactory.registerLoader(wrlbLoader);
+  LoaderPly* plyLoader = new LoaderPly();
+  loaderFactory.registerLoader(plyLoader);
+  LoaderObj* objLoader = new LoaderObj();
+  objLoader->setNumberOfThreads(D._threads);
+  loaderFactory.registerLoader(objLoader);
 
   // register output file savers  
   SaverWrl* wrlSaver = new SaverWrl();
+  wrlSaver->setCompact(D._compact);
   saverFactory.registerSaver(wrlSaver);
   SaverStl* stlSaver = new SaverStl();
+  stlSaver->setBinary(D._binary);
   saverFactory.registerSaver(stlSaver);
+  SaverWrlb* wrlbSaver = new SaverWrlb();
+  saverFactory.registerSaver(wrlbSaver);
+  SaverPly* plySaver = new SaverPly();
+  plySaver->setBinary(D._binary);
+  saverFactory.registerSaver(plySaver);
+  SaverGlb* glbSaver = new SaverGlb();
+  saverFactory.registerSaver(glbSaver);
+
+  FloatFormat format;
+  if(D._quantize>0.0f)
+    format = FloatFormat::quantized(D._quantize);
+  else if(D._shortest)
+    format = FloatFormat::shortest();
+  else if(D._digits>=0)
+    format = FloatFormat::fixed(D._digits);
+
+  // serve conversion requests until a client sends quit //////////////
+
+  if(D._listen!="") {
+    size_t nJobs =
+      (D._jobs>0)?(size_t)D._jobs:(size_t)thread::hardware_concurrency();
+    DgpServer server(loaderFactory,saverFactory,format,nJobs,
+                     (D._cache>0)?(size_t)D._cache:0,D._debug);
+    if(server.run(D._listen.c_str())==false)
+      error("unable to listen on socket");
+    return 0;
+  }
+
+  // convert many files on several threads ////////////////////////////
+
+  if(D._batch) {
+    if(D._stream) error("batch and stream modes can not be combined");
+    return batch(D,loaderFactory,saverFactory,format);
+  }
+
+  // convert STL files without building a SceneGraph ///////////////////
+
+  if(D._stream) {
+    string inExt  = D._inFile.substr(D._inFile.find_last_of('.')+1);
+    string outExt = D._outFile.substr(D._outFile.find_last_of('.')+1);
+    if(inExt!="stl") error("streaming input should be an stl file");
+    if(D._ops.size()>0) error("stream mode can not apply operations");
+    StlSink* sink = (StlSink*)0;
+    if(outExt=="stl") {
+      SaverStlStream* stlStream =
+        new SaverStlStream(D._outFile.c_str(),D._binary,format);
+      if(stlStream->isOpen()) sink = stlStream; else delete stlStream;
+    } else if(outExt=="wrl") {
+      SaverWrlStream* wrlStream =
+        new SaverWrlStream(*wrlSaver,D._outFile.c_str(),format);
+      if(wrlStream->isOpen()) sink = wrlStream; else delete wrlStream;
+    } else {
+      error("streaming output should be an stl or wrl file");
+    }
+    if(sink==(StlSink*)0) error("unable to open outFile");
+    success = stlLoader->stream(D._inFile.c_str(),*sink);
+    delete sink;
+    if(success==false) remove(D._outFile.c_str());
+    if(D._debug) {
+      cerr << "  streaming {" << endl;
+      cerr << "    success        = " << tv(success)          << endl;
+      cerr << "  }" << endl;
+    }
+    return (success)?0:-1;
+  }
 
   // read input file and create SceneGraph /////////////////////////////
 
@@ -153,10 +521,17 @@ int main(int argc, char **argv) {
   if(success==false) return -1;
 
   // process ///////////////////////////////////////////////////////////
-  
-  // if(D._debug) cerr << "  processing {" << endl;
-  // if(D._debug) cerr << "    nothing to do in this assignment" << endl;
-  // if(D._debug) cerr << "  }" << endl;  
+
+  if(D._ops.size()>0) {
+    if(D._debug) cerr << "  processing {" << endl;
+    SceneGraphProcessor processor(wrl);
+    for(const string& op : D._ops) {
+      if(D._debug) cerr << "    " << op << endl;
+      processor.apply(op);
+    }
+    if(D._debug) cerr << "  }" << endl;
+    if(D._debug) cerr << endl;
+  }
 
   // write output file /////////////////////////////////////////////////
   
@@ -165,7 +540,7 @@ int main(int argc, char **argv) {
     cerr << "    fileName       = \"" << D._outFile << "\"" << endl;
   }
 
-  success = saverFactory.save(D._outFile.c_str(),wrl);
+  success = saverFactory.save(D._outFile.c_str(),wrl,format);
 
   if(D._debug) {
     cerr << "    success        = " << tv(success)          << endl;
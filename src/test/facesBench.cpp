@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// facesBench.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// times the per-corner queries of the Faces class on meshes made of
+// faces of a single size, to check that their cost does not depend on
+// the face size; triangle meshes are also timed with TriangleFaces
+//
+// usage: facesBench [numberOfCorners]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+
+using namespace std;
+
+#include <core/Faces.hpp>
+#include <core/TriangleFaces.hpp>
+
+// nF faces of faceSize corners each, with random vertex indices
+static vector<int> makeCoordIndex(const int faceSize, const int nC) {
+  vector<int> coordIndex;
+  int nF = nC/(faceSize+1);
+  if(nF<1) nF = 1;
+  int nV = nF*faceSize/2+1;
+  unsigned int seed = 12345;
+  coordIndex.reserve(nF*(faceSize+1));
+  for(int iF=0;iF<nF;iF++) {
+    for(int j=0;j<faceSize;j++) {
+      seed = seed*1103515245u+12345u;
+      coordIndex.push_back(static_cast<int>((seed>>8)%nV));
+    }
+    coordIndex.push_back(-1);
+  }
+  return coordIndex;
+}
+
+// for every corner, the face, its size and first corner, the vertex,
+// and the next corner; returns nanoseconds per corner
+template <class FacesT>
+static double timeQueries(const FacesT& faces, long long& checksum) {
+  const int nC = faces.getNumberOfCorners();
+  const int nRepeat = 5;
+  auto t0 = chrono::steady_clock::now();
+  for(int r=0;r<nRepeat;r++) {
+    for(int iC=0;iC<nC;iC++) {
+      int iF = faces.getCornerFace(iC);
+      if(iF<0) continue;
+      int iC0 = faces.getFaceFirstCorner(iF);
+      checksum += faces.getFaceSize(iF);
+      checksum += faces.getFaceVertex(iF,iC-iC0);
+      checksum += faces.getNextCorner(iC);
+    }
+  }
+  auto t1 = chrono::steady_clock::now();
+  return chrono::duration<double,nano>(t1-t0).count()/(double(nRepeat)*nC);
+}
+
+int main(int argc, char** argv) {
+  int nC = (argc>1)?atoi(argv[1]):(1<<22);
+  if(nC<=0) {
+    fprintf(stderr,"usage: facesBench [numberOfCorners]\n");
+    return 1;
+  }
+
+  long long checksum = 0;
+  const int faceSizes[] = { 3, 4, 8, 32, 128, 1024 };
+  printf("face size   corners    Faces ns/corner  TriangleFaces ns/corner\n");
+  for(const int faceSize : faceSizes) {
+    vector<int> coordIndex = makeCoordIndex(faceSize,nC);
+    const int n = static_cast<int>(coordIndex.size());
+    Faces faces(0,coordIndex.data(),n);
+    double t = timeQueries(faces,checksum);
+    if(faceSize==3) {
+      TriangleFaces triangleFaces(0,coordIndex.data(),n);
+      double tt = timeQueries(triangleFaces,checksum);
+      printf("%9d %9d %18.2f %24.2f\n",faceSize,n,t,tt);
+    } else {
+      printf("%9d %9d %18.2f %24s\n",faceSize,n,t,"-");
+    }
+  }
+  // keeps the queries from being optimized away
+  printf("checksum %lld\n",checksum);
+  return 0;
+}
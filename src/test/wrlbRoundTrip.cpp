@@ -0,0 +1,171 @@
+//------------------------------------------------------------------------
+//  Copyright (C) Gabriel Taubin
+//  Time-stamp: <2026-10-17 10:00:00 gtaubin>
+//------------------------------------------------------------------------
+//
+// wrlbRoundTrip.cpp
+//
+// Software developed for the course
+// Digital Geometry Processing
+// Copyright (c) 2025, Gabriel Taubin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of the Brown University nor the
+//       names of its contributors may be used to endorse or promote products
+//       derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL GABRIEL TAUBIN BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// checks that nodes shared with DEF/USE in a VRML file are still
+// shared after saving the scene graph as wrlb and loading it back,
+// and that saving it again as VRML writes the same USE references
+//
+// usage: wrlbRoundTrip [workingDirectory]
+
+#include <stdio.h>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <map>
+
+using namespace std;
+
+#include <io/LoaderWrl.hpp>
+#include <io/LoaderWrlb.hpp>
+#include <io/SaverWrl.hpp>
+#include <io/SaverWrlb.hpp>
+#include <wrl/SceneGraph.hpp>
+
+static const char* _input =
+  "#VRML V2.0 utf8\n"
+  "DEF BOLT Transform { children [\n"
+  "  DEF BOLTSHAPE Shape {\n"
+  "    appearance DEF STEEL Appearance {\n"
+  "      material DEF GREY Material { diffuseColor 0.5 0.5 0.5 }\n"
+  "    }\n"
+  "    geometry DEF BOLTGEOM IndexedFaceSet {\n"
+  "      coord Coordinate { point [ 0 0 0 1 0 0 0 1 0 0 0 1 ] }\n"
+  "      coordIndex [ 0 1 2 -1 0 3 1 -1 0 2 3 -1 1 3 2 -1 ]\n"
+  "    }\n"
+  "  }\n"
+  "] }\n"
+  "Transform { translation 2 0 0 children [\n"
+  "  USE BOLTSHAPE\n"
+  "  Shape { appearance USE STEEL geometry USE BOLTGEOM }\n"
+  "  Shape {\n"
+  "    appearance Appearance { material USE GREY }\n"
+  "    geometry USE BOLTGEOM\n"
+  "  }\n"
+  "] }\n";
+
+static int _nErrors = 0;
+
+static void check(const bool ok, const char* what) {
+  if(ok==false) {
+    fprintf(stderr,"FAILED | %s\n",what);
+    _nErrors++;
+  }
+}
+
+static string readFile(const string& filename) {
+  ifstream in(filename);
+  stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+// number of times each word follows a DEF or USE keyword
+static void countNames
+(const string& text, map<string,int>& def, map<string,int>& use) {
+  istringstream in(text);
+  string word,name;
+  while(in >> word) {
+    if(word=="DEF" && (in >> name)) def[name]++;
+    else if(word=="USE" && (in >> name)) use[name]++;
+  }
+}
+
+static Node* child(Node* node, const int i) {
+  if(node==(Node*)0 || node->isGroup()==false) return (Node*)0;
+  vector<pNode>& children = ((Group*)node)->getChildren();
+  return (i<(int)children.size())?children[i]:(Node*)0;
+}
+
+int main(int argc, char** argv) {
+  string dir      = (argc>1)?argv[1]:".";
+  string wrlIn    = dir+"/wrlbRoundTrip_in.wrl";
+  string wrlbFile = dir+"/wrlbRoundTrip.wrlb";
+  string wrlOut   = dir+"/wrlbRoundTrip_out.wrl";
+
+  {
+    ofstream out(wrlIn);
+    out << _input;
+  }
+
+  SceneGraph wrl;
+  LoaderWrl  loaderWrl;
+  LoaderWrlb loaderWrlb;
+  SaverWrl   saverWrl;
+  SaverWrlb  saverWrlb;
+
+  check(loaderWrl.load(wrlIn.c_str(),wrl),"load wrl");
+  check(saverWrlb.save(wrlbFile.c_str(),wrl),"save wrlb");
+  wrl.clear();
+  check(loaderWrlb.load(wrlbFile.c_str(),wrl),"load wrlb");
+
+  // the loaded graph shares the same nodes as the original one
+  Node* bolt   = child(&wrl,0);
+  Node* copies = child(&wrl,1);
+  Shape* s0 = (Shape*)child(bolt,0);
+  Shape* s1 = (Shape*)child(copies,0);
+  Shape* s2 = (Shape*)child(copies,1);
+  Shape* s3 = (Shape*)child(copies,2);
+  bool shapes = s0!=(Shape*)0 && s1!=(Shape*)0 && s2!=(Shape*)0 &&
+    s3!=(Shape*)0 && s0->isShape() && s2->isShape() && s3->isShape();
+  check(shapes,"scene graph structure");
+  if(shapes) {
+    check(s1==s0,"shared Shape");
+    check(s2->getAppearance()==s0->getAppearance(),"shared Appearance");
+    check(s2->getGeometry()==s0->getGeometry(),"shared geometry");
+    check(s3->getGeometry()==s0->getGeometry(),"shared geometry");
+    Appearance* a0 = (Appearance*)s0->getAppearance();
+    Appearance* a3 = (Appearance*)s3->getAppearance();
+    check(a3!=a0,"separate Appearance");
+    if(a0!=(Appearance*)0 && a3!=(Appearance*)0)
+      check(a3->getMaterial()==a0->getMaterial(),"shared Material");
+  }
+
+  // saving it again as VRML writes each DEF once, and every USE
+  check(saverWrl.save(wrlOut.c_str(),wrl),"save wrl");
+  map<string,int> defIn,useIn,defOut,useOut;
+  countNames(_input,defIn,useIn);
+  countNames(readFile(wrlOut),defOut,useOut);
+  for(auto& d : defOut)
+    check(d.second==1,("DEF "+d.first+" written once").c_str());
+  for(auto& u : useIn)
+    check(useOut[u.first]==u.second,("USE "+u.first).c_str());
+
+  if(_nErrors>0) {
+    fprintf(stderr,"wrlbRoundTrip | %d checks failed\n",_nErrors);
+    return 1;
+  }
+  printf("wrlbRoundTrip | OK\n");
+  return 0;
+}
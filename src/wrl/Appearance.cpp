@@ -41,8 +41,10 @@ Appearance::Appearance():
   /* _textureTransform;((Node*)0) */
 {}
 
-Appearance::~Appearance()
-{}
+Appearance::~Appearance() {
+  if(_material!=(Node*)0) _material->unref();
+  if(_texture!=(Node*)0)  _texture->unref();
+}
 
 
 Node* Appearance::getMaterial() {
@@ -59,11 +61,15 @@ Node* Appearance::getTexture() {
 
 void Appearance::setMaterial(Node* material) {
   material->setParent(this);
+  material->ref();
+  if(_material!=(Node*)0) _material->unref();
   _material = material;
 }
 
 void Appearance::setTexture(Node* texture) {
   texture->setParent(this);
+  texture->ref();
+  if(_texture!=(Node*)0) _texture->unref();
   _texture = texture;
 }
 
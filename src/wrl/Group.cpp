@@ -50,7 +50,7 @@ Group::~Group() {
   while(_children.size()>0) {
     child = _children.back();
     _children.pop_back();
-    delete child;
+    child->unref();
   }
 }
 
@@ -97,6 +97,7 @@ float Group::getBBoxDiameter() {
 
 void Group::addChild(const pNode child) {
   child->setParent(this);
+  child->ref();
   _children.push_back(child);
 }
 
@@ -105,7 +106,7 @@ void Group::removeChild(const pNode child) {
   node = find(_children.begin(),_children.end(),child);
   if(node!=_children.end()) {
     _children.erase(node);
-    delete &(*node);
+    child->unref();
   }
 }
 
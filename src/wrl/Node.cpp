@@ -160,7 +160,8 @@ void Vec4f::normalize() {
 Node::Node():
   _name(""),
   _parent((Node*)0),
-  _show(true) {
+  _show(true),
+  _refCount(0) {
 }
 
 Node::~Node() {
@@ -195,6 +196,18 @@ void Node::setShow(const bool value) {
   _show = value;
 }
 
+void Node::ref() {
+  _refCount++;
+}
+
+void Node::unref() {
+  if(--_refCount<=0) delete this;
+}
+
+int Node::getRefCount() const {
+  return _refCount;
+}
+
 int Node::getDepth() const {
   int d = 0;
   const Node* p = _parent;
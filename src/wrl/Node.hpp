@@ -93,6 +93,7 @@ protected:
   string      _name;
   const Node* _parent;
   bool        _show;
+  int         _refCount;
 
 public:
   
@@ -108,6 +109,15 @@ public:
   void            setShow(const bool value);
   int             getDepth() const; 
 
+  // nodes may be shared by several parents, as when a DEF node is
+  // instanced with USE; Group, Shape and Appearance call ref() on the
+  // nodes they hold, and unref() when they release them, and the last
+  // unref() deletes the node; for a shared node getParent() returns
+  // the parent it was last attached to
+  void            ref();
+  void            unref();
+  int             getRefCount() const;
+
   virtual bool    isAppearance() const;
   virtual bool    isGroup() const;
   virtual bool    isImageTexture() const;
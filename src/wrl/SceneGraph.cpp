@@ -49,7 +49,7 @@ void SceneGraph::clear() {
   pNode node;
   while(_children.size()>0) {
     node = _children.back(); _children.pop_back();
-    delete node;
+    node->unref();
   }
 }
 
@@ -41,6 +41,9 @@
 #include "IndexedLineSet.hpp"
 #include "Appearance.hpp"
 #include "Material.hpp"
+#include "core/Faces.hpp"
+#include "core/TriangleFaces.hpp"
+#include "core/Edges.hpp"
 
 SceneGraphProcessor::SceneGraphProcessor(SceneGraph& wrl):
   _wrl(wrl) {
@@ -49,6 +52,64 @@ SceneGraphProcessor::SceneGraphProcessor(SceneGraph& wrl):
 SceneGraphProcessor::~SceneGraphProcessor() {
 }
 
+//////////////////////////////////////////////////////////////////////
+// operations which can be requested by name
+
+typedef void (*NamedOperation)(SceneGraphProcessor& processor);
+
+static const struct {
+  const char*    name;
+  NamedOperation run;
+} _namedOperation[] = {
+  { "normalClear",
+    [](SceneGraphProcessor& p) { p.normalClear();             } },
+  { "normalInvert",
+    [](SceneGraphProcessor& p) { p.normalInvert();            } },
+  { "computeNormalPerFace",
+    [](SceneGraphProcessor& p) { p.computeNormalPerFace();    } },
+  { "computeNormalPerVertex",
+    [](SceneGraphProcessor& p) { p.computeNormalPerVertex();  } },
+  { "computeNormalPerCorner",
+    [](SceneGraphProcessor& p) { p.computeNormalPerCorner();  } },
+  { "bboxAdd",
+    [](SceneGraphProcessor& p) { p.bboxAdd();                 } },
+  { "bboxRemove",
+    [](SceneGraphProcessor& p) { p.bboxRemove();              } },
+  { "edgesAdd",
+    [](SceneGraphProcessor& p) { p.edgesAdd();                } },
+  { "edgesRemove",
+    [](SceneGraphProcessor& p) { p.edgesRemove();             } },
+  { "shapeIndexedFaceSetShow",
+    [](SceneGraphProcessor& p) { p.shapeIndexedFaceSetShow(); } },
+  { "shapeIndexedFaceSetHide",
+    [](SceneGraphProcessor& p) { p.shapeIndexedFaceSetHide(); } },
+  { "shapeIndexedLineSetShow",
+    [](SceneGraphProcessor& p) { p.shapeIndexedLineSetShow(); } },
+  { "shapeIndexedLineSetHide",
+    [](SceneGraphProcessor& p) { p.shapeIndexedLineSetHide(); } },
+  { "pointsRemove",
+    [](SceneGraphProcessor& p) { p.pointsRemove();            } },
+  { "surfaceRemove",
+    [](SceneGraphProcessor& p) { p.surfaceRemove();           } },
+};
+
+bool SceneGraphProcessor::apply(const string& operation) {
+  for(const auto& op : _namedOperation) {
+    if(operation==op.name) {
+      op.run(*this);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SceneGraphProcessor::isOperation(const string& operation) {
+  for(const auto& op : _namedOperation)
+    if(operation==op.name) return true;
+  return false;
+}
+
+//////////////////////////////////////////////////////////////////////
 void SceneGraphProcessor::normalClear() {
   _applyToIndexedFaceSet(_normalClear);
 }
@@ -549,34 +610,34 @@ void SceneGraphProcessor::edgesAdd() {
         coordIls.insert(coordIls.end(),
                         coordIfs.begin(),coordIfs.end());
 
-        int i,i0,i1,nV,iV,iV0,iV1,iF;
-        nV = static_cast<int>(coordIfs.size()/3);
-        for(iV=0;iV<nV;iV++) {
-          coordIls.push_back(coordIfs[3*iV  ]);
-          coordIls.push_back(coordIfs[3*iV+1]);
-          coordIls.push_back(coordIfs[3*iV+2]);
+        // one line per unique edge, rather than one per half-edge
+        int nV = static_cast<int>(coordIfs.size()/3);
+        const int* ci = coordIndexIfs.data();
+        int nC = static_cast<int>(coordIndexIfs.size());
+        if(ifs->isTriangleMesh()) {
+          _edgesAddLines(TriangleFaces(nV,ci,nC),coordIndexIls);
+        } else {
+          _edgesAddLines(Faces(nV,ci,nC),coordIndexIls);
         }
 
-        for(iF=i0=i1=0;i1<(int)coordIndexIfs.size();i1++) {
-          if(coordIndexIfs[i1]<0) {
-            iV0 = coordIndexIfs[i1-1];
-            for(i=i0;i<i1;i++) {
-              iV1 = coordIndexIfs[i];
-              coordIndexIls.push_back(iV0);
-              coordIndexIls.push_back(iV1);
-              coordIndexIls.push_back(-1);
-              iV0 = iV1;
-            }
-            iF++; i0 = i1+1;
-          }
-        }
-
-
       }
     }
   }
 }
 
+template <class FacesT>
+void SceneGraphProcessor::_edgesAddLines
+(const FacesT& faces, vector<int>& coordIndexIls) {
+  Edges edges(faces);
+  int iE,nE = edges.getNumberOfEdges();
+  coordIndexIls.reserve(coordIndexIls.size()+3*nE);
+  for(iE=0;iE<nE;iE++) {
+    coordIndexIls.push_back(edges.getVertex0(iE));
+    coordIndexIls.push_back(edges.getVertex1(iE));
+    coordIndexIls.push_back(-1);
+  }
+}
+
 void SceneGraphProcessor::edgesRemove() {
   SceneGraphTraversal traversal(_wrl);
   traversal.start();
@@ -86,6 +86,11 @@ public:
   void pointsRemove();
   void surfaceRemove();
 
+  // runs the operation named as the method without arguments which
+  // implements it, as in "edgesAdd"; bboxAdd uses its default values;
+  // returns false, without changing the scene graph, for other names
+  bool apply(const string& operation);
+  static bool isOperation(const string& operation);
 
 private:
 
@@ -104,6 +109,11 @@ private:
               (vector<float>& coord, vector<int>&   coordIndex,
                int i0, int i1, Vec3f& n, bool normalize);
 
+  // FacesT is either Faces or TriangleFaces
+  template <class FacesT>
+  static void _edgesAddLines
+              (const FacesT& faces, vector<int>& coordIndexIls);
+
   bool        _hasShapeProperty(Shape::Property p);
   bool        _hasIndexedFaceSetProperty(IndexedFaceSet::Property p);
   bool        _hasIndexedLineSetProperty(IndexedLineSet::Property p);
@@ -42,6 +42,8 @@ Shape::Shape():
 }
 
 Shape::~Shape() {
+  if(_appearance!=(Node*)0) _appearance->unref();
+  if(_geometry!=(Node*)0)   _geometry->unref();
 }
 
 Node* Shape::getAppearance() {
@@ -102,11 +104,15 @@ bool Shape::hasGeometryUnsupported() {
 
 void Shape::setAppearance(Node* node) {
   node->setParent(this);
+  node->ref();
+  if(_appearance!=(Node*)0) _appearance->unref();
   _appearance = node;
 }
 
 void Shape::setGeometry(Node* node) {
   node->setParent(this);
+  node->ref();
+  if(_geometry!=(Node*)0) _geometry->unref();
   _geometry = node;
 }
 